@@ -1,14 +1,27 @@
 // SYCL-PRNG includes
 #include <PRNG/TinyMT.hpp>
 #include <PRNG/MWC64X.hpp>
+#include <PRNG/Bulk.hpp>
+#include <PRNG/AsyncEngine.hpp>
+#include <PRNG/RandomAccess.hpp>
+#include <PRNG/LeapfrogEngine.hpp>
+#include <PRNG/DiscreteDistribution.hpp>
+#include <PRNG/Algorithm.hpp>
+#include <PRNG/BernoulliDistribution.hpp>
 
 // Standard C++ includes
 #include <random>
 #include <vector>
+#include <map>
 #include <iterator>
+#include <numeric>
 #include <algorithm>
 #include <iostream>
 #include <typeinfo>
+#include <functional>
+#include <stdexcept>
+#include <chrono>
+#include <thread>
 
 
 int main()
@@ -74,5 +87,456 @@ int main()
     match_skip_vs_step(tmt32, tmt32_ref);
     match_skip_vs_step(mwc32, mwc32_ref);
 
+    auto match_bulk_vs_single = [&](auto engine_ref, prng::isa path)
+    {
+        using engine_type = decltype(engine_ref);
+        using result_type = typename engine_type::result_type;
+
+        // select_isa() clamps to what the CPU supports
+        if (prng::select_isa(path) != path)
+        {
+            std::cout << "Bulk vs. single skipped for " <<
+                typeid(engine_ref).name() <<
+                " on unsupported instruction set " <<
+                static_cast<int>(path) <<
+                "." <<
+                std::endl;
+
+            return;
+        }
+
+        const std::size_t count = 37, per_engine = 100;
+
+        std::vector<result_type> seeds;
+        std::generate_n(std::back_inserter(seeds), count, [&]() { return static_cast<result_type>(re()); });
+
+        std::vector<engine_type> singles( seeds.cbegin(), seeds.cend() ); // seeding CTOR
+        std::vector<result_type> single_values;
+        for (auto& engine : singles)
+            std::generate_n(std::back_inserter(single_values), per_engine, std::ref(engine)); // operator()
+
+        std::vector<engine_type> bulks(count);
+        std::vector<result_type> bulk_values(count * per_engine);
+        prng::seed_n(bulks.data(), seeds.data(), count); // batched seeding
+        prng::generate_n(bulks.data(), count, bulk_values.data(), per_engine); // batched generation
+
+        if (bulks != singles || bulk_values != single_values)
+        {
+            std::cerr << "Bulk vs. single differs for " <<
+                typeid(engine_ref).name() <<
+                " on instruction set " <<
+                static_cast<int>(prng::active_isa()) <<
+                "." <<
+                std::endl;
+
+            std::exit(EXIT_FAILURE);
+        }
+    };
+
+    for (auto path : { prng::isa::scalar, prng::isa::sse4_2, prng::isa::avx2, prng::isa::avx512 })
+    {
+        match_bulk_vs_single(prng::tinymt_64{}, path);
+        match_bulk_vs_single(prng::tinymt_32{}, path);
+        match_bulk_vs_single(prng::mwc64x_32{}, path);
+    }
+
+    prng::select_isa(prng::supported_isa());
+
+    auto match_async_vs_sync = [&](auto engine_ref)
+    {
+        using engine_type = decltype(engine_ref);
+        using result_type = typename engine_type::result_type;
+
+        prng::async_engine_config config;
+        config.block_size = 100;
+        config.ring_depth = 3;
+
+        engine_type sync{ static_cast<result_type>(re()) };
+        prng::async_engine<engine_type> async{ sync, config }; // copy of sync
+
+        std::vector<result_type> sync_values, async_values(2000);
+        std::generate_n(std::back_inserter(sync_values), 4000, std::ref(sync)); // operator()
+
+        std::generate_n(async_values.begin(), 1000, std::ref(async)); // operator()
+        std::this_thread::sleep_for(std::chrono::milliseconds{ 10 }); // producer parks on the full ring
+        async.generate(async_values.begin() + 1000, async_values.end()); // block copies
+        std::generate_n(std::back_inserter(async_values), 2000, std::ref(async));
+
+        if (async_values != sync_values)
+        {
+            std::cerr << "Async vs. sync differs for " <<
+                typeid(engine_ref).name() <<
+                "." <<
+                std::endl;
+
+            std::exit(EXIT_FAILURE);
+        }
+    };
+
+    match_async_vs_sync(prng::tinymt_64{});
+    match_async_vs_sync(prng::tinymt_32{});
+    match_async_vs_sync(prng::mwc64x_32{});
+
+    auto match_random_access_vs_step = [&](auto engine_ref)
+    {
+        using engine_type = decltype(engine_ref);
+        using result_type = typename engine_type::result_type;
+
+        const result_type seed = static_cast<result_type>(re());
+
+        engine_type engine{ seed };
+        std::vector<result_type> values;
+        std::generate_n(std::back_inserter(values), 20'000, std::ref(engine)); // operator()
+
+        // Forward steps, rollbacks within and beyond the checkpoints, long jumps
+        prng::random_access<engine_type> cache{ seed };
+        prng::random_access<engine_type, 1> single{ seed };
+
+        const std::int64_t window = static_cast<std::int64_t>(cache.window);
+        std::uniform_int_distribution<std::int64_t> delta{ -window - window / 2, window + 2 };
+        std::int64_t index = 0;
+
+        for (int i = 0; i < 5'000; ++i)
+        {
+            index = (i % 50 == 0) ? static_cast<std::int64_t>(re() % values.size())
+                                  : std::min<std::int64_t>(std::max<std::int64_t>(index + delta(re), 0), values.size() - 1);
+
+            if (cache.value_at(index) != values[index] ||
+                single.value_at(index) != values[index] ||
+                engine_type::value_at(seed, index) != values[index])
+            {
+                std::cerr << "Random access vs. step differs for " <<
+                    typeid(engine_ref).name() <<
+                    " at index " <<
+                    index <<
+                    "." <<
+                    std::endl;
+
+                std::exit(EXIT_FAILURE);
+            }
+        }
+    };
+
+    match_random_access_vs_step(prng::tinymt_64{});
+    match_random_access_vs_step(prng::tinymt_32{});
+    match_random_access_vs_step(prng::mwc64x_32{});
+
+    auto match_leapfrog_vs_step = [&](auto engine_ref)
+    {
+        using engine_type = decltype(engine_ref);
+        using result_type = typename engine_type::result_type;
+
+        const engine_type origin{ static_cast<result_type>(re()) };
+
+        engine_type engine = origin; // copy CTOR
+        std::vector<result_type> values;
+        std::generate_n(std::back_inserter(values), 30'000, std::ref(engine)); // operator()
+
+        // Strides around the stepping thresholds of the jumps
+        for (std::size_t stride : { 1, 2, 3, 9, 10, 11, 255, 256, 300, 5'000 })
+            for (std::size_t rank : { std::size_t{ 0 }, stride / 2, stride - 1 })
+            {
+                prng::leapfrog_engine<engine_type> leapfrog{ origin, rank, stride };
+
+                for (std::size_t i = rank; i < values.size(); i += stride)
+                    if (leapfrog() != values[i])
+                    {
+                        std::cerr << "Leapfrog vs. step differs for " <<
+                            typeid(engine_ref).name() <<
+                            " with stride " <<
+                            stride <<
+                            " at index " <<
+                            i <<
+                            "." <<
+                            std::endl;
+
+                        std::exit(EXIT_FAILURE);
+                    }
+            }
+
+        for (auto rank_stride : { std::make_pair(0ull, 0ull), std::make_pair(4ull, 4ull) })
+        {
+            try
+            {
+                prng::leapfrog_engine<engine_type> leapfrog{ origin, rank_stride.first, rank_stride.second };
+
+                std::cerr << "Leapfrog accepted rank " << rank_stride.first << " of stride " << rank_stride.second << "." << std::endl;
+
+                std::exit(EXIT_FAILURE);
+            }
+            catch (std::invalid_argument&) {}
+        }
+    };
+
+    match_leapfrog_vs_step(prng::tinymt_64{});
+    match_leapfrog_vs_step(prng::tinymt_32{});
+    match_leapfrog_vs_step(prng::mwc64x_32{});
+
+    auto match_alias_table_vs_threads = [&]()
+    {
+        // Spans several blocks, with zero weights left to pair across them
+        std::uniform_real_distribution<double> weight{ 0.0, 10.0 };
+        std::vector<double> weights;
+        std::generate_n(std::back_inserter(weights), 3 * prng::alias_table::block_size + 12'345, [&]() { return weight(re); });
+        for (std::size_t i = 0; i < weights.size(); i += 7) weights[i] = 0;
+
+        const prng::alias_table single{ weights, 1 }, multi{ weights, 7 };
+
+        for (std::uint32_t i = 0; i < single.size(); ++i)
+            if (single.data()[i].threshold != multi.data()[i].threshold ||
+                single.data()[i].alias != multi.data()[i].alias ||
+                (weights[i] == 0 && single.data()[i].threshold != 0))
+            {
+                std::cerr << "Alias table differs between 1 and 7 threads at column " << i << "." << std::endl;
+
+                std::exit(EXIT_FAILURE);
+            }
+
+        prng::mwc64x_32 engine{ static_cast<prng::mwc64x_32::result_type>(re()) };
+        for (int i = 0; i < 100'000; ++i)
+            if (weights[single(engine)] == 0)
+            {
+                std::cerr << "Alias table sampled a category of zero weight." << std::endl;
+
+                std::exit(EXIT_FAILURE);
+            }
+    };
+
+    match_alias_table_vs_threads();
+
+    auto match_shuffle_vs_threads = [&](auto engine_ref)
+    {
+        using engine_type = decltype(engine_ref);
+        using result_type = typename engine_type::result_type;
+
+        const engine_type origin{ static_cast<result_type>(re()) };
+
+        // Long enough to take the bucket path
+        std::vector<std::uint32_t> single(300'001), multi;
+        std::iota(single.begin(), single.end(), 0u);
+        multi = single;
+
+        engine_type single_engine = origin, multi_engine = origin;
+        prng::parallel_shuffle(single.begin(), single.end(), single_engine, 1);
+        prng::parallel_shuffle(multi.begin(), multi.end(), multi_engine, 7);
+
+        std::vector<std::uint32_t> sorted = single;
+        std::sort(sorted.begin(), sorted.end());
+
+        if (single != multi || single_engine != multi_engine ||
+            sorted[0] != 0 || std::adjacent_find(sorted.cbegin(), sorted.cend(), [](std::uint32_t l, std::uint32_t r) { return r != l + 1; }) != sorted.cend())
+        {
+            std::cerr << "Parallel shuffle differs between 1 and 7 threads for " <<
+                typeid(engine_ref).name() <<
+                "." <<
+                std::endl;
+
+            std::exit(EXIT_FAILURE);
+        }
+
+        // Sparse and dense samples, and k > n
+        engine_type engine = origin;
+        for (auto k_n : { std::make_pair(10ull, 1'000'000ull), std::make_pair(900ull, 1'000ull), std::make_pair(50ull, 20ull) })
+        {
+            std::vector<std::uint64_t> picks;
+            prng::sample(k_n.first, k_n.second, std::back_inserter(picks), engine);
+
+            std::sort(picks.begin(), picks.end());
+
+            if (picks.size() != std::min(k_n.first, k_n.second) ||
+                std::adjacent_find(picks.cbegin(), picks.cend()) != picks.cend() ||
+                (!picks.empty() && picks.back() >= k_n.second))
+            {
+                std::cerr << "Sample of " <<
+                    k_n.first <<
+                    " from " <<
+                    k_n.second <<
+                    " is not distinct for " <<
+                    typeid(engine_ref).name() <<
+                    "." <<
+                    std::endl;
+
+                std::exit(EXIT_FAILURE);
+            }
+        }
+
+        // Serial shuffles are permutations, all 24 orders of 4 drawn evenly
+        for (std::size_t n : { 0, 1, 2, 3, 1'001 })
+        {
+            std::vector<std::size_t> perm(n);
+            std::iota(perm.begin(), perm.end(), std::size_t{ 0 });
+            prng::shuffle(perm.begin(), perm.end(), engine);
+
+            std::sort(perm.begin(), perm.end());
+            for (std::size_t i = 0; i < n; ++i)
+                if (perm[i] != i)
+                {
+                    std::cerr << "Shuffle of " <<
+                        n <<
+                        " elements is not a permutation for " <<
+                        typeid(engine_ref).name() <<
+                        "." <<
+                        std::endl;
+
+                    std::exit(EXIT_FAILURE);
+                }
+        }
+
+        std::map<std::vector<int>, int> orders;
+        for (int i = 0; i < 24'000; ++i)
+        {
+            std::vector<int> perm{ 0, 1, 2, 3 };
+            prng::shuffle(perm.begin(), perm.end(), engine);
+            ++orders[perm];
+        }
+
+        // About 7 standard deviations around 1000 each
+        if (orders.size() != 24 || std::any_of(orders.cbegin(), orders.cend(), [](const std::pair<const std::vector<int>, int>& o) { return o.second < 780 || o.second > 1'220; }))
+        {
+            std::cerr << "Shuffle orders are not uniform for " <<
+                typeid(engine_ref).name() <<
+                "." <<
+                std::endl;
+
+            std::exit(EXIT_FAILURE);
+        }
+
+        // Reservoir samples: k beyond the range, k = 0, and even inclusion
+        const std::vector<int> range{ 5, 4, 3, 2, 1 };
+        std::vector<int> reservoir(8, -1);
+
+        if (prng::sample(range.cbegin(), range.cend(), reservoir.begin(), 8, engine) != reservoir.begin() + 5 ||
+            !std::equal(range.cbegin(), range.cend(), reservoir.cbegin()) ||
+            prng::sample(range.cbegin(), range.cend(), reservoir.begin() + 5, 0, engine) != reservoir.begin() + 5 ||
+            reservoir[5] != -1)
+        {
+            std::cerr << "Reservoir sample of a short range or of 0 elements is wrong for " <<
+                typeid(engine_ref).name() <<
+                "." <<
+                std::endl;
+
+            std::exit(EXIT_FAILURE);
+        }
+
+        std::vector<int> population(100), inclusions(100);
+        std::iota(population.begin(), population.end(), 0);
+        for (int i = 0; i < 20'000; ++i)
+        {
+            std::vector<int> picks(10);
+            prng::sample(population.cbegin(), population.cend(), picks.begin(), picks.size(), engine);
+
+            std::sort(picks.begin(), picks.end());
+            if (std::adjacent_find(picks.cbegin(), picks.cend()) != picks.cend())
+            {
+                std::cerr << "Reservoir sample is not distinct for " <<
+                    typeid(engine_ref).name() <<
+                    "." <<
+                    std::endl;
+
+                std::exit(EXIT_FAILURE);
+            }
+
+            for (int p : picks) ++inclusions[p];
+        }
+
+        // About 7 standard deviations around 2000 each
+        if (std::any_of(inclusions.cbegin(), inclusions.cend(), [](int c) { return c < 1'700 || c > 2'300; }))
+        {
+            std::cerr << "Reservoir sample is not uniform for " <<
+                typeid(engine_ref).name() <<
+                "." <<
+                std::endl;
+
+            std::exit(EXIT_FAILURE);
+        }
+    };
+
+    match_shuffle_vs_threads(prng::tinymt_64{});
+    match_shuffle_vs_threads(prng::tinymt_32{});
+    match_shuffle_vs_threads(prng::mwc64x_32{});
+
+    auto match_bit_pool_vs_words = [&](auto engine_ref)
+    {
+        using engine_type = decltype(engine_ref);
+        using result_type = typename engine_type::result_type;
+
+        constexpr unsigned word_bits = prng::bit_pool<engine_type>::word_bits;
+
+        static_assert(std::is_standard_layout<prng::bit_pool<engine_type>>::value, "Bit pool is not standard layout.");
+
+        const engine_type origin{ static_cast<result_type>(re()) };
+
+        // Engine words as a bit stream, least significant bit first
+        engine_type engine = origin;
+        std::vector<bool> stream;
+        for (int i = 0; i < 1'000; ++i)
+        {
+            const result_type word = engine();
+            for (unsigned b = 0; b < word_bits; ++b) stream.push_back((word >> b) & 1);
+        }
+
+        // Single bits, fields of every width, straddling words, and full words
+        prng::bit_pool<engine_type> pool{ origin };
+        std::size_t pos = 0;
+        for (unsigned k = 1; pos + 2 * word_bits < stream.size(); k = k % word_bits + 1)
+        {
+            const result_type field = k == 1 ? pool.bit() : k == word_bits ? pool() : pool.bits(k);
+
+            for (unsigned b = 0; b < k; ++b, ++pos)
+                if (((field >> b) & 1) != stream[pos])
+                {
+                    std::cerr << "Bit pool differs from engine words for " <<
+                        typeid(engine_ref).name() <<
+                        " at bit " <<
+                        pos <<
+                        "." <<
+                        std::endl;
+
+                    std::exit(EXIT_FAILURE);
+                }
+        }
+
+        const prng::bernoulli_distribution never{ 0.0 }, always{ 1.0 };
+        for (int i = 0; i < 10'000; ++i)
+            if (never(pool) || !always(pool) || never(engine) || !always(engine))
+            {
+                std::cerr << "Bernoulli distribution with p of 0 or 1 is random for " << typeid(engine_ref).name() << "." << std::endl;
+
+                std::exit(EXIT_FAILURE);
+            }
+    };
+
+    static_assert(std::is_standard_layout<prng::bernoulli_distribution>::value, "Bernoulli distribution is not standard layout.");
+
+    // p survives being held as 64 bits only, for p of at least 2^-11 exactly
+    for (double p : { 0.0, 0.25, 0.3, 0.999, 1.0 })
+        if (prng::bernoulli_distribution{ p }.p() != p ||
+            prng::bernoulli_distribution{ p } != prng::bernoulli_distribution{ p } ||
+            prng::bernoulli_distribution{ p } == prng::bernoulli_distribution{ p / 2 + 0.01 })
+        {
+            std::cerr << "Bernoulli distribution does not keep p of " << p << "." << std::endl;
+
+            std::exit(EXIT_FAILURE);
+        }
+
+    match_bit_pool_vs_words(prng::tinymt_64{});
+    match_bit_pool_vs_words(prng::tinymt_32{});
+    match_bit_pool_vs_words(prng::mwc64x_32{});
+
+#ifdef __linux__
+    try
+    {
+        prng::async_engine_config config;
+        config.cpu = 1 << 20;
+
+        prng::async_engine<prng::mwc64x_32> pinned{ prng::mwc64x_32{}, config };
+
+        std::cerr << "Async engine accepted out of range cpu " << config.cpu << "." << std::endl;
+
+        std::exit(EXIT_FAILURE);
+    }
+    catch (std::invalid_argument&) {}
+#endif
+
     return 0;
 }
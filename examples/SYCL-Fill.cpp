@@ -0,0 +1,100 @@
+﻿// SYCL-PRNG includes
+#include <PRNG/TinyMT.hpp>
+#include <PRNG/MWC64X.hpp>
+#include <PRNG/BernoulliDistribution.hpp>
+#include <PRNG/SYCLFill.hpp>
+
+// SYCL includes
+#include <CL/sycl.hpp>
+
+// Standard C++ includes
+#include <cstdint>
+#include <cstdlib>
+#include <type_traits>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <typeinfo>
+
+int main()
+{
+    // Sample params
+    const auto dev_type = cl::sycl::info::device_type::cpu;
+    const std::size_t length = 1000003u;
+    const std::uint32_t seed = 5489u;
+
+    try
+    {
+        // Device selection, falling back to the host device
+        std::vector<cl::sycl::device> devs;
+        for (const auto& plat : cl::sycl::platform::get_platforms())
+            for (const auto& dev : plat.get_devices(dev_type)) devs.push_back(dev);
+
+        auto dev = devs.empty() ? cl::sycl::device{ cl::sycl::host_selector{} } : devs.front();
+
+        std::cout << "Selected device: " << dev.get_info<cl::sycl::info::device::name>() << "\n" << std::endl;
+
+        auto async_error_handler = [](cl::sycl::exception_list errors) { for (auto error : errors) std::rethrow_exception(error); };
+
+        cl::sycl::queue queue{ dev, async_error_handler };
+
+        auto match_device_vs_host = [&](auto engine_tag, auto& buf, auto&& fill_device, auto&& fill_host)
+        {
+            using engine_type = decltype(engine_tag);
+            using value_type = typename std::remove_reference_t<decltype(buf)>::value_type;
+
+            fill_device(buf);
+
+            std::vector<value_type> ref(length);
+            fill_host(ref.begin());
+
+            auto acc = buf.template get_access<cl::sycl::access::mode::read>();
+
+            if (!std::equal(ref.begin(), ref.end(), acc.get_pointer()))
+            {
+                std::cerr << "Device fill differs from host reference for " <<
+                    typeid(engine_type).name() <<
+                    std::endl;
+
+                std::exit(EXIT_FAILURE);
+            }
+        };
+
+        auto match_fill = [&](auto engine_tag)
+        {
+            using engine_type = decltype(engine_tag);
+            using result_type = typename engine_type::result_type;
+
+            cl::sycl::buffer<result_type> values{ cl::sycl::range<1>{ length } };
+            cl::sycl::buffer<std::uint8_t> flips{ cl::sycl::range<1>{ length } };
+
+            const prng::bernoulli_distribution coin{ 0.3 };
+
+            match_device_vs_host(engine_tag, values,
+                [&](auto& buf) { prng::sycl::fill<engine_type>(queue, buf, length, seed); },
+                [&](auto out) { prng::fill<engine_type>(out, length, seed); });
+
+            match_device_vs_host(engine_tag, flips,
+                [&](auto& buf) { prng::sycl::fill_distribution<engine_type>(queue, buf, length, seed, coin); },
+                [&](auto out) { prng::fill_distribution<engine_type>(out, length, seed, coin); });
+        };
+
+        match_fill(prng::tinymt_64{});
+        match_fill(prng::tinymt_32{});
+        match_fill(prng::mwc64x_32{});
+
+        std::cout << "Result verification passed!" << std::endl;
+    }
+    catch (cl::sycl::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        std::exit(e.get_cl_code());
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+
+    return 0;
+}
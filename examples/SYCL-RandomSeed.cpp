@@ -32,7 +32,7 @@ int main()
     const std::size_t dev_index = std::numeric_limits<std::size_t>::max();
     const auto dev_type = cl::sycl::info::device_type::gpu;
     const std::size_t length = 65536u;
-    const std::size_t num = 64;
+    const std::size_t num = 1000; // long enough for discard to jump
     std::mt19937_64 a;
     try
     {
@@ -114,7 +114,7 @@ int main()
             queue.submit([&](cl::sycl::handler& cgh)
             {
                 auto seeds = seeds_buf.get_access<cl::sycl::access::mode::read>();
-                auto engines = skip_seq.template get_access<cl::sycl::access::mode::write>();
+                auto engines = step_seq.template get_access<cl::sycl::access::mode::write>();
 
                 using engine_type = typename decltype(engines)::value_type;
 
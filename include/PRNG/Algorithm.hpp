@@ -0,0 +1,216 @@
+// Copyright(c) 2018 Mt Ferenc Nagy-Egri, Wigner GPU-Laboratory.
+//
+// All rights reserved.
+//
+// The 3-clause BSD License is applied to this software, see LICENSE.txt
+//
+
+#pragma once
+
+// SYCL-PRNG includes
+#include <PRNG/detail/Uniform.hpp>
+#include <PRNG/detail/Parallel.hpp>
+
+// Standard C++ includes
+#include <cstddef>          // std::size_t
+#include <cstdint>          // std::uint8_t, std::uint64_t
+#include <cmath>            // std::exp, std::log, std::log1p, std::floor
+#include <iterator>         // std::iterator_traits
+#include <utility>          // std::swap, std::move
+#include <vector>           // std::vector
+#include <unordered_set>    // std::unordered_set
+
+namespace prng
+{
+    // Fisher-Yates shuffle. Positions are drawn in pairs from single 64-bit
+    // draws while their product fits, halving the calls of 64-bit engines.
+    template <typename RandomIt, typename Engine>
+    void shuffle(RandomIt first, RandomIt last, Engine& engine)
+    {
+        using std::swap;
+
+        std::uint64_t i = static_cast<std::uint64_t>(last - first);
+
+        for (; i > 0x100000000; --i)
+            swap(first[i - 1], first[detail::uniform_below(engine, i)]);
+
+        for (; i > 2; i -= 2)
+        {
+            std::uint64_t j0, j1;
+            detail::uniform_below(engine, i, i - 1, j0, j1);
+
+            swap(first[i - 1], first[j0]);
+            swap(first[i - 2], first[j1]);
+        }
+
+        if (i == 2) swap(first[0], first[detail::uniform_below(engine, 2)]);
+    }
+
+    namespace detail
+    {
+        // Substreams handed to blocks and buckets of a parallel shuffle
+        constexpr unsigned shuffle_substream_log2 = 40;
+
+        template <typename Engine>
+        Engine shuffle_substream(const Engine& engine, std::size_t s)
+        {
+            Engine result = engine;
+            result.discard(static_cast<unsigned long long>(s + 1) << shuffle_substream_log2);
+            return result;
+        }
+    }
+
+    // Shuffles on multiple threads by scattering elements into 256 random
+    // buckets (Rao-Sandelius), then Fisher-Yates shuffling every bucket.
+    //
+    // Blocks of the input and buckets each draw from their own substream of
+    // engine split off by discard(), so the result depends only on the
+    // engine state, never on the number of threads. Intended for engines with
+    // fast discard(). Afterwards engine is advanced past all substreams used.
+    template <typename RandomIt, typename Engine>
+    void parallel_shuffle(RandomIt first, RandomIt last, Engine& engine, unsigned threads = 0)
+    {
+        using value_type = typename std::iterator_traits<RandomIt>::value_type;
+
+        constexpr std::size_t buckets = 256,
+                              block_size = 65536;
+
+        const std::size_t n = static_cast<std::size_t>(last - first),
+                          blocks = (n + block_size - 1) / block_size;
+
+        // Splitting off substreams does not pay off for short ranges
+        if (n <= block_size)
+        {
+            shuffle(first, last, engine);
+            return;
+        }
+
+        // Bucket of each element, 8 uniform bits per draw
+        std::vector<std::uint8_t> bucket_of(n);
+        std::vector<std::size_t> offsets(blocks * buckets);
+        detail::parallel_for(blocks, threads, [&](std::size_t b)
+        {
+            Engine e = detail::shuffle_substream(engine, b);
+            std::size_t* counts = offsets.data() + b * buckets;
+
+            for (std::size_t i = b * block_size; i < n && i < (b + 1) * block_size; i += 8)
+            {
+                std::uint64_t bits = detail::uniform_bits64(e);
+
+                for (std::size_t k = i; k < i + 8 && k < n; ++k, bits >>= 8)
+                {
+                    bucket_of[k] = static_cast<std::uint8_t>(bits);
+                    ++counts[bucket_of[k]];
+                }
+            }
+        });
+
+        // Bucket-major exclusive scan, so blocks scatter to disjoint ranges
+        std::vector<std::size_t> bucket_begin(buckets + 1);
+        for (std::size_t k = 0, sum = 0; k < buckets; ++k)
+        {
+            bucket_begin[k] = sum;
+            for (std::size_t b = 0; b < blocks; ++b)
+            {
+                const std::size_t count = offsets[b * buckets + k];
+                offsets[b * buckets + k] = sum;
+                sum += count;
+            }
+        }
+        bucket_begin[buckets] = n;
+
+        std::vector<value_type> scratch(n);
+        detail::parallel_for(blocks, threads, [&](std::size_t b)
+        {
+            std::size_t* next = offsets.data() + b * buckets;
+
+            for (std::size_t i = b * block_size; i < n && i < (b + 1) * block_size; ++i)
+                scratch[next[bucket_of[i]]++] = std::move(first[i]);
+        });
+
+        detail::parallel_for(buckets, threads, [&](std::size_t k)
+        {
+            Engine e = detail::shuffle_substream(engine, blocks + k);
+
+            shuffle(scratch.begin() + bucket_begin[k], scratch.begin() + bucket_begin[k + 1], e);
+
+            for (std::size_t i = bucket_begin[k]; i < bucket_begin[k + 1]; ++i)
+                first[i] = std::move(scratch[i]);
+        });
+
+        engine = detail::shuffle_substream(engine, blocks + buckets);
+    }
+
+    // Writes min(k, n) distinct integers drawn uniformly from [0, n) to out,
+    // in no particular order, using Floyd's algorithm. Membership is tracked
+    // in a bitmap when the sample is dense and in a hash set otherwise.
+    template <typename OutputIt, typename Engine>
+    OutputIt sample(std::uint64_t k, std::uint64_t n, OutputIt out, Engine& engine)
+    {
+        if (k > n) k = n;
+
+        if (k > n / 64)
+        {
+            std::vector<bool> chosen(static_cast<std::size_t>(n));
+
+            for (std::uint64_t j = n - k; j < n; ++j)
+            {
+                std::uint64_t t = detail::uniform_below(engine, j + 1);
+                if (chosen[t]) t = j;
+
+                chosen[t] = true;
+                *out++ = t;
+            }
+        }
+        else
+        {
+            std::unordered_set<std::uint64_t> chosen(static_cast<std::size_t>(2 * k));
+
+            for (std::uint64_t j = n - k; j < n; ++j)
+            {
+                std::uint64_t t = detail::uniform_below(engine, j + 1);
+                if (!chosen.insert(t).second)
+                {
+                    t = j;
+                    chosen.insert(t);
+                }
+
+                *out++ = t;
+            }
+        }
+
+        return out;
+    }
+
+    // Reservoir sampling of k elements from a range of unknown length into
+    // out[0, k), using Li's Algorithm L which skips over elements with
+    // geometrically distributed jumps. Returns the end of the filled range.
+    template <typename InputIt, typename RandomIt, typename Engine>
+    RandomIt sample(InputIt first, InputIt last, RandomIt out, std::size_t k, Engine& engine)
+    {
+        std::size_t i = 0;
+        for (; i < k && first != last; ++i, ++first) out[i] = *first;
+
+        if (i < k || k == 0) return out + i;
+
+        // Uniform on (0, 1]
+        auto uniform = [&]() { return static_cast<double>((detail::uniform_bits64(engine) >> 11) + 1) / 9007199254740992.0; };
+
+        double w = std::exp(std::log(uniform()) / static_cast<double>(k));
+
+        while (first != last)
+        {
+            for (double skip = std::floor(std::log(uniform()) / std::log1p(-w)); skip > 0 && first != last; --skip)
+                ++first;
+
+            if (first == last) break;
+
+            out[detail::uniform_below(engine, k)] = *first;
+            ++first;
+
+            w *= std::exp(std::log(uniform()) / static_cast<double>(k));
+        }
+
+        return out + k;
+    }
+}
@@ -0,0 +1,219 @@
+// Copyright(c) 2018 Mt Ferenc Nagy-Egri, Wigner GPU-Laboratory.
+//
+// All rights reserved.
+//
+// The 3-clause BSD License is applied to this software, see LICENSE.txt
+//
+
+#pragma once
+
+// Standard C++ includes
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint64_t
+#include <atomic>       // std::atomic
+#include <thread>       // std::thread, std::this_thread::yield
+#include <mutex>        // std::mutex, std::unique_lock
+#include <condition_variable>   // std::condition_variable
+#include <vector>       // std::vector
+#include <algorithm>    // std::copy_n, std::min
+#include <stdexcept>    // std::invalid_argument
+#include <system_error> // std::system_error
+
+#ifdef __linux__
+#include <pthread.h>    // pthread_setaffinity_np
+#include <sched.h>      // cpu_set_t
+#endif
+
+namespace prng
+{
+    struct async_engine_config
+    {
+        std::size_t block_size = 4096;  // values per ring block
+        std::size_t ring_depth = 8;     // blocks in flight
+        int cpu = -1;                   // core to pin the producer to, -1 for none
+    };
+
+    // Runs Engine on a producer thread, which fills a single-producer
+    // single-consumer ring of fixed size blocks ahead of the consumer.
+    // The values returned are the exact sequence of the wrapped engine.
+    //
+    // Only one thread may consume from an async_engine. The hot path touches
+    // no atomics, those are only accessed when crossing block boundaries.
+    // A producer facing a full ring spins briefly, then sleeps until the
+    // consumer releases a block.
+    template <typename Engine>
+    class async_engine
+    {
+    public:
+
+        using result_type = typename Engine::result_type;
+
+        struct statistics
+        {
+            std::uint64_t blocks_consumed;
+            std::uint64_t consumer_stalls;  // block boundaries where no block was ready
+        };
+
+        explicit async_engine(const Engine& engine = Engine{}, async_engine_config config = {})
+            : config_(config)
+            , engine_(engine)
+        {
+            if (config_.block_size == 0 || config_.ring_depth == 0)
+                throw std::invalid_argument{ "async_engine requires non-empty blocks and ring." };
+#ifdef __linux__
+            if (config_.cpu >= CPU_SETSIZE)
+                throw std::invalid_argument{ "async_engine cpu exceeds CPU_SETSIZE." };
+#endif
+
+            ring_.resize(config_.block_size * config_.ring_depth);
+            pos_ = config_.block_size; // forces acquiring the first block
+
+            producer_ = std::thread{ [this]() { produce(); } };
+
+#ifdef __linux__
+            if (config_.cpu >= 0)
+            {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(config_.cpu, &set);
+
+                const int error = pthread_setaffinity_np(producer_.native_handle(), sizeof(set), &set);
+                if (error != 0)
+                {
+                    stop();
+                    throw std::system_error{ error, std::system_category(), "async_engine cannot pin producer" };
+                }
+            }
+#endif
+        }
+
+        async_engine(const async_engine&) = delete;
+        async_engine& operator=(const async_engine&) = delete;
+
+        ~async_engine() { stop(); }
+
+        result_type operator()()
+        {
+            if (pos_ == config_.block_size) acquire_block();
+
+            return block_[pos_++];
+        }
+
+        // Fills [first, last) with the next values, copying whole blocks at once.
+        template <typename RandomIt>
+        void generate(RandomIt first, RandomIt last)
+        {
+            std::size_t n = static_cast<std::size_t>(last - first);
+
+            while (n != 0)
+            {
+                if (pos_ == config_.block_size) acquire_block();
+
+                const std::size_t m = std::min(n, config_.block_size - pos_);
+
+                first = std::copy_n(block_ + pos_, m, first);
+                pos_ += m;
+                n -= m;
+            }
+        }
+
+        statistics stats() const { return { consumed_, stalls_ }; }
+
+        const async_engine_config& config() const { return config_; }
+
+        static constexpr result_type min() { return Engine::min(); }
+        static constexpr result_type max() { return Engine::max(); }
+
+    private:
+
+        async_engine_config config_;
+        Engine engine_;                 // owned by the producer after construction
+        std::vector<result_type> ring_;
+
+        // Blocks produced and released so far, monotonically increasing
+        alignas(64) std::atomic<std::uint64_t> head_{ 0 };
+        alignas(64) std::atomic<std::uint64_t> tail_{ 0 };
+        std::atomic<bool> stop_{ false };
+
+        // Parking of the producer on a full ring
+        static constexpr unsigned spin_limit = 256;
+        std::atomic<bool> sleeping_{ false };
+        std::mutex mutex_;
+        std::condition_variable released_;
+
+        // Consumer-only state
+        alignas(64) const result_type* block_ = nullptr;
+        std::size_t pos_;
+        std::uint64_t consumed_ = 0;
+        std::uint64_t stalls_ = 0;
+
+        std::thread producer_;
+
+        void acquire_block()
+        {
+            if (block_ != nullptr)
+            {
+                // Sequentially consistent, pairing with the producer raising
+                // sleeping_ before it checks tail_ one last time
+                tail_.store(consumed_, std::memory_order_seq_cst);
+
+                if (sleeping_.load(std::memory_order_seq_cst))
+                {
+                    std::lock_guard<std::mutex> lock{ mutex_ };
+                    released_.notify_one();
+                }
+            }
+
+            if (head_.load(std::memory_order_acquire) == consumed_)
+            {
+                ++stalls_;
+                while (head_.load(std::memory_order_acquire) == consumed_) std::this_thread::yield();
+            }
+
+            block_ = ring_.data() + (consumed_ % config_.ring_depth) * config_.block_size;
+            pos_ = 0;
+            ++consumed_;
+        }
+
+        void produce()
+        {
+            for (std::uint64_t produced = 0; ; ++produced)
+            {
+                auto full = [&]() { return produced - tail_.load(std::memory_order_seq_cst) == config_.ring_depth; };
+
+                for (unsigned spins = 0; full(); ++spins)
+                {
+                    if (stop_.load(std::memory_order_relaxed)) return;
+
+                    if (spins < spin_limit)
+                        std::this_thread::yield();
+                    else
+                    {
+                        std::unique_lock<std::mutex> lock{ mutex_ };
+
+                        sleeping_.store(true, std::memory_order_seq_cst);
+                        released_.wait(lock, [&]() { return !full() || stop_.load(std::memory_order_relaxed); });
+                        sleeping_.store(false, std::memory_order_relaxed);
+                    }
+                }
+                if (stop_.load(std::memory_order_relaxed)) return;
+
+                result_type* block = ring_.data() + (produced % config_.ring_depth) * config_.block_size;
+                for (std::size_t i = 0; i < config_.block_size; ++i) block[i] = engine_();
+
+                head_.store(produced + 1, std::memory_order_release);
+            }
+        }
+
+        void stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock{ mutex_ };
+                stop_.store(true, std::memory_order_relaxed);
+            }
+            released_.notify_one();
+
+            producer_.join();
+        }
+    };
+}
@@ -0,0 +1,111 @@
+// Copyright(c) 2018 Mt Ferenc Nagy-Egri, Wigner GPU-Laboratory.
+//
+// All rights reserved.
+//
+// The 3-clause BSD License is applied to this software, see LICENSE.txt
+//
+
+#pragma once
+
+// SYCL-PRNG includes
+#include <PRNG/BitPool.hpp>
+#include <PRNG/detail/Uniform.hpp>
+
+// Standard C++ includes
+#include <cstdint>  // std::uint64_t
+#include <cmath>    // std::ldexp
+
+namespace prng
+{
+    // Drop-in for std::bernoulli_distribution with p resolved to 64 bits.
+    //
+    // Drawing from a bit_pool compares the binary expansion of a uniform
+    // variate against that of p bit by bit, consuming bits only up to the
+    // first difference. That takes two bits on average instead of a full
+    // word. The comparison itself runs on whole buffered words.
+    // Other engines are compared a whole 64-bit draw at once; both agree
+    // in distribution but not in the values drawn.
+    //
+    // Standard layout and free of floating point members, usable inside
+    // SYCL kernels on devices without fp64. Only the constructor and p()
+    // compute in double, both on the host.
+    class bernoulli_distribution
+    {
+    public:
+
+        using result_type = bool;
+
+        // p in [0, 1]
+        explicit bernoulli_distribution(double p = 0.5)
+            : threshold_(p <= 0 ? 0 :
+                         p >= 1 ? ~std::uint64_t{ 0 } :
+                                  static_cast<std::uint64_t>(std::ldexp(p, 64)))
+            , reversed_(0)
+            , certain_(p >= 1)
+        {
+            for (unsigned i = 0; i < 64; ++i)
+                reversed_ |= ((threshold_ >> (63 - i)) & 1) << i;
+        }
+
+        template <typename Engine>
+        result_type operator()(bit_pool<Engine>& pool) const
+        {
+            // Bits of p after the binary point, the first one lowest
+            std::uint64_t q = reversed_;
+
+            for (unsigned left = 64; left != 0;)
+            {
+                const std::uint64_t u = pool.peek();
+                const unsigned k = pool.buffered() < left ? pool.buffered() : left;
+
+                const std::uint64_t diff = (u ^ q) & (k == 64 ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << k) - 1);
+
+                if (diff != 0)
+                {
+                    const unsigned i = detail::count_trailing_zeros(diff);
+
+                    pool.skip(i + 1);
+
+                    return ((q >> i) & 1) != 0;
+                }
+
+                pool.skip(k);
+                q = k == 64 ? 0 : q >> k;
+                left -= k;
+            }
+
+            // All 64 bits tied, so u < p holds only for p = 1
+            return certain_;
+        }
+
+        template <typename Engine>
+        result_type operator()(Engine& engine) const
+        {
+            return detail::uniform_bits64(engine) < threshold_ || certain_;
+        }
+
+        void reset() {}
+
+        // p as resolved to 64 bits
+        double p() const { return certain_ ? 1.0 : std::ldexp(static_cast<double>(threshold_), -64); }
+
+        static constexpr result_type min() { return false; }
+        static constexpr result_type max() { return true; }
+
+        friend bool operator==(const bernoulli_distribution& lhs, const bernoulli_distribution& rhs)
+        {
+            return lhs.threshold_ == rhs.threshold_ && lhs.certain_ == rhs.certain_;
+        }
+
+        friend bool operator!=(const bernoulli_distribution& lhs, const bernoulli_distribution& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+
+        std::uint64_t threshold_,
+                      reversed_;
+        bool certain_;  // p >= 1, which threshold_ cannot represent
+    };
+}
@@ -0,0 +1,128 @@
+// Copyright(c) 2018 Mt Ferenc Nagy-Egri, Wigner GPU-Laboratory.
+//
+// All rights reserved.
+//
+// The 3-clause BSD License is applied to this software, see LICENSE.txt
+//
+
+#pragma once
+
+// Standard C++ includes
+#include <cstddef>  // std::size_t
+
+namespace prng
+{
+    // Serves single bits and short bit fields out of buffered engine words,
+    // so that a coin flip costs a shift instead of a full engine call.
+    // Bits are handed out starting from the least significant end of each
+    // word, fields straddling two words take their high bits from the next.
+    //
+    // Standard layout and free of dynamic memory, usable inside SYCL kernels.
+    template <typename Engine>
+    class bit_pool
+    {
+    public:
+
+        using result_type = typename Engine::result_type;
+
+        static constexpr unsigned word_bits = sizeof(result_type) * 8;
+
+        explicit bit_pool(const Engine& engine)
+            : engine_(engine)
+            , pool_(0)
+            , count_(0)
+        {}
+
+        bit_pool() : bit_pool(Engine{}) {}
+
+        bool bit()
+        {
+            if (count_ == 0) refill();
+
+            const bool result = (pool_ & 1) != 0;
+
+            pool_ >>= 1;
+            --count_;
+
+            return result;
+        }
+
+        // The next k bits as an integer, for 1 <= k <= word_bits
+        result_type bits(unsigned k)
+        {
+            result_type result = 0;
+            unsigned got = 0;
+
+            if (count_ < k)
+            {
+                result = pool_;
+                got = count_;
+
+                refill();
+            }
+
+            const unsigned need = k - got;
+
+            result |= static_cast<result_type>((pool_ & low_mask(need)) << got);
+            skip(need);
+
+            return result;
+        }
+
+        // The buffered() bits, next one lowest, refilling the pool when empty
+        result_type peek()
+        {
+            if (count_ == 0) refill();
+
+            return pool_;
+        }
+
+        // Drops the next k <= buffered() bits
+        void skip(unsigned k)
+        {
+            pool_ = k == word_bits ? 0 : static_cast<result_type>(pool_ >> k);
+            count_ -= k;
+        }
+
+        // A full word, so that the pool may stand in for its engine
+        result_type operator()() { return bits(word_bits); }
+
+        // Bits left over from the last engine word
+        unsigned buffered() const { return count_; }
+
+        const Engine& engine() const { return engine_; }
+
+        friend bool operator==(const bit_pool& lhs, const bit_pool& rhs)
+        {
+            return (lhs.count_ == rhs.count_) &&
+                   (lhs.pool_ == rhs.pool_) &&
+                   (lhs.engine_ == rhs.engine_);
+        }
+
+        friend bool operator!=(const bit_pool& lhs, const bit_pool& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+        static constexpr result_type min() { return Engine::min(); }
+        static constexpr result_type max() { return Engine::max(); }
+
+    private:
+
+        Engine engine_;
+        result_type pool_;
+        unsigned count_;
+
+        void refill()
+        {
+            pool_ = engine_();
+            count_ = word_bits;
+        }
+
+        static result_type low_mask(unsigned k)
+        {
+            return k == word_bits ? static_cast<result_type>(~result_type{ 0 })
+                                  : static_cast<result_type>((result_type{ 1 } << k) - 1);
+        }
+    };
+}
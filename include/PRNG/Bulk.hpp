@@ -0,0 +1,92 @@
+// Copyright(c) 2018 Mt Ferenc Nagy-Egri, Wigner GPU-Laboratory.
+//
+// All rights reserved.
+//
+// The 3-clause BSD License is applied to this software, see LICENSE.txt
+//
+
+#pragma once
+
+// SYCL-PRNG includes
+#include <PRNG/Dispatch.hpp>
+
+// Standard C++ includes
+#include <cstddef>  // std::size_t
+
+namespace prng
+{
+    namespace detail
+    {
+        // Every path instantiates the same engine kernels, only the instruction
+        // set they are compiled for differs, hence outputs are bit-identical.
+#define PRNG_DEFINE_BULK_KERNELS(name_, attr_)                                          \
+        template <typename Engine, typename Seed>                                       \
+        attr_ void seed_n_##name_(Engine* out, const Seed* seeds, std::size_t n)        \
+        {                                                                               \
+            Engine::seed_n(out, seeds, n);                                              \
+        }                                                                               \
+                                                                                        \
+        template <typename Engine>                                                      \
+        attr_ void generate_n_##name_(Engine* engines, std::size_t count,               \
+                                      typename Engine::result_type* out,                \
+                                      std::size_t per_engine)                           \
+        {                                                                               \
+            Engine::generate_n(engines, count, out, per_engine);                        \
+        }
+
+        PRNG_DEFINE_BULK_KERNELS(scalar, )
+#ifdef PRNG_MULTIVERSIONING
+        PRNG_DEFINE_BULK_KERNELS(sse4_2, PRNG_TARGET("sse4.2"))
+        PRNG_DEFINE_BULK_KERNELS(avx2, PRNG_TARGET("avx2"))
+        PRNG_DEFINE_BULK_KERNELS(avx512, PRNG_TARGET("avx512f,avx512dq,avx512bw,avx512vl"))
+#endif
+
+#undef PRNG_DEFINE_BULK_KERNELS
+    }
+
+    // Initializes out[0..n) as if each were constructed from seeds[i].
+    //
+    // Kernels skip dispatch, which reads static storage, and run the scalar
+    // path, which uses no dynamic memory. Hence seed_n may be called from
+    // within a SYCL kernel to seed a contiguous chunk of engines per
+    // work-item.
+    template <typename Engine, typename Seed>
+    void seed_n(Engine* out, const Seed* seeds, std::size_t n)
+    {
+#ifdef __SYCL_DEVICE_ONLY__
+        Engine::seed_n(out, seeds, n);
+#else
+        switch (active_isa())
+        {
+#ifdef PRNG_MULTIVERSIONING
+        case isa::avx512: detail::seed_n_avx512(out, seeds, n); break;
+        case isa::avx2:   detail::seed_n_avx2(out, seeds, n); break;
+        case isa::sse4_2: detail::seed_n_sse4_2(out, seeds, n); break;
+#endif
+        default:          detail::seed_n_scalar(out, seeds, n); break;
+        }
+#endif
+    }
+
+    // Advances count engines per_engine times each, writing the outputs of
+    // engines[i] to out[i * per_engine, (i + 1) * per_engine). Like seed_n,
+    // usable within SYCL kernels.
+    template <typename Engine>
+    void generate_n(Engine* engines, std::size_t count,
+                    typename Engine::result_type* out, std::size_t per_engine)
+    {
+#ifdef __SYCL_DEVICE_ONLY__
+        Engine::generate_n(engines, count, out, per_engine);
+#else
+        switch (active_isa())
+        {
+#ifdef PRNG_MULTIVERSIONING
+        case isa::avx512: detail::generate_n_avx512(engines, count, out, per_engine); break;
+        case isa::avx2:   detail::generate_n_avx2(engines, count, out, per_engine); break;
+        case isa::sse4_2: detail::generate_n_sse4_2(engines, count, out, per_engine); break;
+#endif
+        default:          detail::generate_n_scalar(engines, count, out, per_engine); break;
+        }
+#endif
+    }
+}
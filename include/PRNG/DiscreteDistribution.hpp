@@ -0,0 +1,220 @@
+// Copyright(c) 2018 Mt Ferenc Nagy-Egri, Wigner GPU-Laboratory.
+//
+// All rights reserved.
+//
+// The 3-clause BSD License is applied to this software, see LICENSE.txt
+//
+
+#pragma once
+
+// SYCL-PRNG includes
+#include <PRNG/detail/Uniform.hpp>
+#include <PRNG/detail/Parallel.hpp>
+
+// Standard C++ includes
+#include <cstddef>          // std::size_t
+#include <cstdint>          // std::uint32_t, std::uint64_t
+#include <cmath>            // std::isfinite, std::ldexp
+#include <limits>           // std::numeric_limits
+#include <vector>           // std::vector
+#include <algorithm>        // std::min
+#include <initializer_list> // std::initializer_list
+#include <stdexcept>        // std::invalid_argument
+
+namespace prng
+{
+    // Column of an alias table. Column i yields i when the fractional part
+    // of the draw is below threshold (a 0.64 fixed point probability), alias
+    // otherwise. Full columns alias themselves.
+    struct alias_entry
+    {
+        std::uint64_t threshold;
+        std::uint32_t alias;
+    };
+
+    // Samples a category from a flat alias table of n columns using a single
+    // 64-bit draw: its product with n selects the column by the high word and
+    // decides between the column and its alias by the low word.
+    //
+    // Works on raw pointers, hence usable on SYCL buffers of alias_entry.
+    template <typename Engine>
+    std::uint32_t alias_sample(const alias_entry* table, std::uint32_t n, Engine& engine)
+    {
+        std::uint64_t column, fraction;
+        detail::mul_wide(detail::uniform_bits64(engine), n, column, fraction);
+
+        return fraction < table[column].threshold ? static_cast<std::uint32_t>(column)
+                                                  : table[column].alias;
+    }
+
+    // Host-side builder and owner of an alias table (Walker, Vose).
+    //
+    // Construction processes fixed size blocks of categories in parallel and
+    // pairs up what is left over across blocks afterwards, so the table only
+    // depends on the weights, not on the number of threads.
+    class alias_table
+    {
+    public:
+
+        static constexpr std::size_t block_size = 65536;
+
+        template <typename InputIt>
+        alias_table(InputIt first, InputIt last, unsigned threads = 0)
+            : alias_table(std::vector<double>(first, last), threads)
+        {}
+
+        alias_table(std::initializer_list<double> weights, unsigned threads = 0)
+            : alias_table(std::vector<double>(weights), threads)
+        {}
+
+        alias_table(const std::vector<double>& weights, unsigned threads = 0)
+        {
+            build(weights, threads);
+        }
+
+        template <typename Engine>
+        std::uint32_t operator()(Engine& engine) const
+        {
+            return alias_sample(table_.data(), size(), engine);
+        }
+
+        const alias_entry* data() const { return table_.data(); }
+        std::uint32_t size() const { return static_cast<std::uint32_t>(table_.size()); }
+
+    private:
+
+        std::vector<alias_entry> table_;
+
+        // Category whose column is still open, with its scaled weight
+        struct open_column
+        {
+            std::uint32_t index;
+            double p;
+        };
+
+        // Pairs light columns with heavy ones. Light columns are stacked on
+        // work[lo, s), heavy ones on work[l, hi), both tops facing each other;
+        // unpaired ones are left there. Scaled weights average to 1.
+        void pair(open_column* work, std::size_t lo, std::size_t& s, std::size_t& l, std::size_t hi)
+        {
+            while (s != lo && l != hi)
+            {
+                const open_column light = work[--s];
+                open_column& heavy = work[l];
+
+                table_[light.index] = { to_threshold(light.p), heavy.index };
+
+                heavy.p = (heavy.p + light.p) - 1;
+
+                if (heavy.p < 1) work[s++] = work[l++];
+            }
+        }
+
+        void build(const std::vector<double>& weights, unsigned threads)
+        {
+            const std::size_t n = weights.size(),
+                              blocks = (n + block_size - 1) / block_size;
+
+            if (n == 0 || n > std::numeric_limits<std::uint32_t>::max())
+                throw std::invalid_argument{ "alias_table requires between 1 and 2^32-1 weights." };
+
+            // Normalize, summing per block in block order to stay deterministic.
+            // Invalid weights poison their block's sum with NaN.
+            std::vector<double> sums(blocks);
+            detail::parallel_for(blocks, threads, [&](std::size_t b)
+            {
+                double sum = 0;
+                for (std::size_t i = b * block_size; i < n && i < (b + 1) * block_size; ++i)
+                    sum += weights[i] >= 0 ? weights[i] : std::numeric_limits<double>::quiet_NaN();
+                sums[b] = sum;
+            });
+
+            double total = 0;
+            for (double sum : sums) total += sum;
+
+            if (!(total > 0) || !std::isfinite(total))
+                throw std::invalid_argument{ "alias_table weights must be finite, non-negative and not all zero." };
+
+            const double scale = static_cast<double>(n) / total;
+
+            table_.resize(n);
+
+            // Pair within blocks first
+            std::vector<open_column> work(n);
+            std::vector<std::size_t> small_end(blocks), large_begin(blocks);
+            detail::parallel_for(blocks, threads, [&](std::size_t b)
+            {
+                const std::size_t lo = b * block_size,
+                                  hi = n < lo + block_size ? n : lo + block_size;
+                std::size_t s = lo, l = hi;
+
+                for (std::size_t i = lo; i < hi; ++i)
+                {
+                    const open_column c{ static_cast<std::uint32_t>(i), weights[i] * scale };
+                    work[c.p < 1 ? s++ : --l] = c;
+                }
+
+                pair(work.data(), lo, s, l, hi);
+
+                small_end[b] = s;
+                large_begin[b] = l;
+            });
+
+            // Then whatever is left over across blocks
+            std::vector<open_column> rest;
+            for (std::size_t b = 0; b < blocks; ++b)
+                rest.insert(rest.end(), work.begin() + b * block_size, work.begin() + small_end[b]);
+
+            std::size_t s = rest.size();
+            for (std::size_t b = blocks; b-- != 0;)
+                rest.insert(rest.end(), work.begin() + large_begin[b], work.begin() + std::min(n, (b + 1) * block_size));
+
+            std::size_t l = s;
+            pair(rest.data(), 0, s, l, rest.size());
+
+            // Leftovers are full up to rounding errors
+            for (std::size_t i = 0; i < s; ++i) table_[rest[i].index] = { full, rest[i].index };
+            for (std::size_t i = l; i < rest.size(); ++i) table_[rest[i].index] = { full, rest[i].index };
+        }
+
+        static constexpr std::uint64_t full = std::numeric_limits<std::uint64_t>::max();
+
+        static std::uint64_t to_threshold(double p)
+        {
+            return p <= 0 ? 0 : static_cast<std::uint64_t>(std::ldexp(p, 64));
+        }
+    };
+
+    // Draws indices of weights like std::discrete_distribution, sampling in
+    // O(1) through an alias table instead of a binary search over cumulative
+    // weights. Not a drop-in replacement, as it lacks param_type,
+    // probabilities() and the (count, xmin, xmax, fw) constructor.
+    template <typename IntType = std::uint32_t>
+    class discrete_distribution
+    {
+    public:
+
+        using result_type = IntType;
+
+        discrete_distribution() : table_({ 1.0 }) {}
+
+        template <typename InputIt>
+        discrete_distribution(InputIt first, InputIt last, unsigned threads = 0) : table_(first, last, threads) {}
+
+        discrete_distribution(std::initializer_list<double> weights) : table_(weights) {}
+
+        template <typename Engine>
+        result_type operator()(Engine& engine) const { return static_cast<result_type>(table_(engine)); }
+
+        void reset() {}
+
+        const alias_table& table() const { return table_; }
+
+        result_type min() const { return 0; }
+        result_type max() const { return static_cast<result_type>(table_.size() - 1); }
+
+    private:
+
+        alias_table table_;
+    };
+}
@@ -0,0 +1,79 @@
+// Copyright(c) 2018 Mt Ferenc Nagy-Egri, Wigner GPU-Laboratory.
+//
+// All rights reserved.
+//
+// The 3-clause BSD License is applied to this software, see LICENSE.txt
+//
+
+#pragma once
+
+// Standard C++ includes
+#include <atomic>   // std::atomic
+
+// Function multiversioning is only available through GCC-style target
+// attributes on x86 hosts. Elsewhere every path collapses onto scalar.
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__)) && \
+    !defined(__SYCL_DEVICE_ONLY__)
+#define PRNG_MULTIVERSIONING 1
+#define PRNG_TARGET(isa_) __attribute__((target(isa_), flatten))
+#endif
+
+namespace prng
+{
+    // Instruction sets host bulk kernels are compiled for, in ascending order.
+    enum class isa
+    {
+        scalar,
+        sse4_2,
+        avx2,
+        avx512
+    };
+
+    namespace detail
+    {
+        inline isa detect_isa()
+        {
+#ifdef PRNG_MULTIVERSIONING
+            __builtin_cpu_init();
+
+            if (__builtin_cpu_supports("avx512f") &&
+                __builtin_cpu_supports("avx512dq") &&
+                __builtin_cpu_supports("avx512bw") &&
+                __builtin_cpu_supports("avx512vl")) return isa::avx512;
+            if (__builtin_cpu_supports("avx2")) return isa::avx2;
+            if (__builtin_cpu_supports("sse4.2")) return isa::sse4_2;
+#endif
+            return isa::scalar;
+        }
+
+        inline std::atomic<isa>& selected_isa()
+        {
+            static std::atomic<isa> selected{ detect_isa() };
+
+            return selected;
+        }
+    }
+
+    // Best instruction set supported by the executing CPU.
+    inline isa supported_isa()
+    {
+        static const isa supported = detail::detect_isa();
+
+        return supported;
+    }
+
+    // Instruction set used by bulk kernels, resolved on first call.
+    inline isa active_isa() { return detail::selected_isa().load(std::memory_order_relaxed); }
+
+    // Forces bulk kernels onto a given path, clamped to what the CPU supports.
+    // Returns the path actually selected.
+    inline isa select_isa(isa requested)
+    {
+        const isa selected = requested < supported_isa() ? requested : supported_isa();
+
+        detail::selected_isa().store(selected, std::memory_order_relaxed);
+
+        return selected;
+    }
+}
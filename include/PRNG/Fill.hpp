@@ -0,0 +1,58 @@
+// Copyright(c) 2018 Mt Ferenc Nagy-Egri, Wigner GPU-Laboratory.
+//
+// All rights reserved.
+//
+// The 3-clause BSD License is applied to this software, see LICENSE.txt
+//
+
+#pragma once
+
+// Standard C++ includes
+#include <cstddef>  // std::size_t
+
+namespace prng
+{
+    namespace detail
+    {
+        // Values of a distribution fill drawn from the same substream
+        constexpr std::size_t fill_block = 4096;
+
+        // Distance between the substreams of consecutive blocks, in values
+        constexpr unsigned long long fill_substream_log2 = 32;
+    }
+
+    // Writes the first n values of Engine{ seed } to out. Host reference of
+    // prng::sycl::fill, which produces the very same values on devices.
+    template <typename Engine, typename OutputIt>
+    OutputIt fill(OutputIt out, std::size_t n, typename Engine::result_type seed)
+    {
+        Engine engine{ seed };
+
+        for (; n != 0; --n) *out++ = engine();
+
+        return out;
+    }
+
+    // Writes n values of dist to out. Host reference of
+    // prng::sycl::fill_distribution.
+    //
+    // Values are drawn in blocks of detail::fill_block, block b from a fresh
+    // copy of dist and Engine{ seed } jumped ahead by b * 2^32. Blocks thus
+    // do not depend on each other, whatever number of engine values dist
+    // consumes, and may be generated in any order or in parallel.
+    template <typename Engine, typename OutputIt, typename Distribution>
+    OutputIt fill_distribution(OutputIt out, std::size_t n, typename Engine::result_type seed, const Distribution& dist)
+    {
+        const typename Engine::jump_ahead next_block{ 1ull << detail::fill_substream_log2 };
+
+        for (Engine block{ seed }; n != 0; next_block(block))
+        {
+            Engine engine = block;
+            Distribution d = dist;
+
+            for (std::size_t k = 0; k < detail::fill_block && n != 0; ++k, --n) *out++ = d(engine);
+        }
+
+        return out;
+    }
+}
@@ -0,0 +1,78 @@
+// Copyright(c) 2018 Mt Ferenc Nagy-Egri, Wigner GPU-Laboratory.
+//
+// All rights reserved.
+//
+// The 3-clause BSD License is applied to this software, see LICENSE.txt
+//
+
+#pragma once
+
+// Standard C++ includes
+#include <stdexcept>    // std::invalid_argument
+
+namespace prng
+{
+    // Yields every stride-th value of engine, starting with the rank-th one,
+    // so that stride instances of ranks 0..stride-1 partition a single stream.
+    //
+    // The jump over the stride - 1 skipped values is precomputed once through
+    // Engine::jump_ahead. Both engines step short strides. Beyond those, MWC64X
+    // multiplies by A^(stride-1) modulo M per value and TinyMT applies the
+    // jump polynomial.
+    template <typename Engine>
+    class leapfrog_engine
+    {
+    public:
+
+        using result_type = typename Engine::result_type;
+
+        leapfrog_engine(const Engine& engine, unsigned long long rank, unsigned long long stride)
+            : engine_(engine)
+            , skip_(stride - 1)
+            , stride_(stride)
+        {
+            if (stride == 0 || rank >= stride)
+                throw std::invalid_argument{ "leapfrog_engine requires rank < stride." };
+
+            engine_.discard(rank);
+        }
+
+        leapfrog_engine(const leapfrog_engine&) = default;
+
+        result_type operator()()
+        {
+            result_type result = engine_();
+
+            skip_(engine_);
+
+            return result;
+        }
+
+        void discard(unsigned long long z) { engine_.discard(z * stride_); }
+
+        unsigned long long stride() const { return stride_; }
+
+        // The wrapped engine, positioned at the next value to be returned
+        const Engine& base() const { return engine_; }
+
+        friend bool operator==(const leapfrog_engine& lhs, const leapfrog_engine& rhs)
+        {
+            return (lhs.stride_ == rhs.stride_) &&
+                   (lhs.engine_ == rhs.engine_);
+        }
+
+        friend bool operator!=(const leapfrog_engine& lhs, const leapfrog_engine& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+        static constexpr result_type min() { return Engine::min(); }
+        static constexpr result_type max() { return Engine::max(); }
+
+    private:
+
+        Engine engine_;
+        typename Engine::jump_ahead skip_;
+        unsigned long long stride_;
+    };
+}
@@ -9,6 +9,9 @@
 
 #pragma once
 
+// SYCL-PRNG includes
+#include <PRNG/detail/Uniform.hpp>
+
 #ifdef __SYCL_DEVICE_ONLY__
 // SYCL include
 #include <CL/sycl.hpp>
@@ -42,23 +45,132 @@ namespace prng
         multiply_with_carry_engine_32() : multiply_with_carry_engine_32(default_seed) {}
         multiply_with_carry_engine_32(const multiply_with_carry_engine_32&) = default;
 
+        // Seeds partition the period into disjoint substreams of 2^stream_log2
+        // values each, by jumping from base_id as the original MWC64X does.
         void seed(result_type value = default_seed)
         {
+            std::uint64_t m_ = pow_a(static_cast<std::uint64_t>(value) << stream_log2);
+            set_state(mul_mod64(base_id, m_, m));
         }
         //template <typename Sseq> void seed(Sseq& s);
 
         result_type operator()()
         {
-            next_state();
+            next_state(x, c);
 
             return x ^ c;
         }
 
+        // Distances below which discard steps instead of jumping
+        static constexpr unsigned long long discard_threshold = 32;
+
         void discard(unsigned long long z)
         {
-            auto tmp = skip_impl_mod64({ x, c }, z);
-            x = tmp[0];
-            c = tmp[1];
+            if (z < discard_threshold)
+                for (; 0 < z; --z) next_state(x, c);
+            else
+            {
+                auto tmp = skip_impl_mod64({ x, c }, z);
+                x = tmp[0];
+                c = tmp[1];
+            }
+        }
+
+        // Engine seeded with seed that has already produced index values
+        static multiply_with_carry_engine_32 state_at(result_type seed, unsigned long long index)
+        {
+            multiply_with_carry_engine_32 engine{ seed };
+            engine.discard(index);
+            return engine;
+        }
+
+        // The index-th value produced by an engine seeded with seed
+        static result_type value_at(result_type seed, unsigned long long index)
+        {
+            return state_at(seed, index)();
+        }
+
+        // Advances engines by a fixed distance. Short distances are stepped,
+        // for longer ones construction computes A^z mod M, after which each
+        // application costs a single multiplication modulo M.
+        class jump_ahead
+        {
+        public:
+
+            explicit jump_ahead(unsigned long long z)
+                : m_(z < step_threshold ? 0 : mul_mod64(pow_a(z), mul_shift, m))
+                , z_(z)
+            {}
+
+            // Jump by zero
+            jump_ahead() : m_(0), z_(0) {}
+
+            void operator()(multiply_with_carry_engine_32& engine) const
+            {
+                if (z_ < step_threshold)
+                    for (unsigned long long i = 0; i < z_; ++i) next_state(engine.x, engine.c);
+                else
+                    engine.set_state(mul_mod_m(engine.x * static_cast<std::uint64_t>(a) + engine.c, m_));
+            }
+
+        private:
+
+            std::uint64_t m_;   // A^z * 2^96 mod M, see mul_mod_m
+            unsigned long long z_;
+        };
+
+        // Seeds n engines at once, yielding the same states as constructing
+        // out[i] from seeds[i].
+        template <typename Seed>
+        static void seed_n(multiply_with_carry_engine_32* out, const Seed* seeds, std::size_t n)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+                out[i].seed(static_cast<result_type>(seeds[i]));
+        }
+
+        // Advances count engines per_engine times each, writing the outputs of
+        // engines[i] to out[i * per_engine, (i + 1) * per_engine).
+        static void generate_n(multiply_with_carry_engine_32* engines, std::size_t count,
+                               result_type* out, std::size_t per_engine)
+        {
+            for (std::size_t b = 0; b < count; b += simd_lanes)
+            {
+                const std::size_t w = count - b < simd_lanes ? count - b : simd_lanes;
+
+                result_type xs[simd_lanes], cs[simd_lanes];
+
+                for (std::size_t l = 0; l < simd_lanes; ++l)
+                {
+                    xs[l] = engines[b + (l < w ? l : 0)].x;
+                    cs[l] = engines[b + (l < w ? l : 0)].c;
+                }
+
+                // Outputs are gathered into a tile, so that each lane stores
+                // contiguous runs instead of striding through memory per value.
+                for (std::size_t i = 0; i < per_engine; i += simd_lanes)
+                {
+                    const std::size_t h = per_engine - i < simd_lanes ? per_engine - i : simd_lanes;
+
+                    result_type r[simd_lanes][simd_lanes];
+
+                    for (std::size_t k = 0; k < h; ++k)
+                        for (std::size_t l = 0; l < simd_lanes; ++l)
+                        {
+                            next_state(xs[l], cs[l]);
+                            r[k][l] = xs[l] ^ cs[l];
+                        }
+
+                    for (std::size_t l = 0; l < w; ++l)
+                        for (std::size_t k = 0; k < h; ++k)
+                            out[(b + l) * per_engine + i + k] = r[k][l];
+                }
+
+                for (std::size_t l = 0; l < w; ++l)
+                {
+                    engines[b + l].x = xs[l];
+                    engines[b + l].c = cs[l];
+                }
+            }
         }
 
         friend bool operator==(const multiply_with_carry_engine_32<A, M>& lhs,
@@ -86,21 +198,75 @@ namespace prng
         static constexpr auto a = A;
         static constexpr auto m = M;
 
-        inline void next_state()
+        // Arbitrary starting point of the LCG jumps, see MWC_SeedImpl_Mod64
+        static constexpr std::uint64_t base_id = 4077358422479273989ull;
+        static constexpr std::size_t stream_log2 = 31;
+        static constexpr std::size_t simd_lanes = 16;
+
+        // Distances below which stepping beats a jump
+        static constexpr unsigned long long step_threshold = 10;
+
+        // Powers A^(d * 16^k) mod M for every hex digit d of a 64-bit exponent
+        struct jump_table
+        {
+            std::uint64_t pow[16][16];
+        };
+
+        // Const and constant initialized like mul_shift, hence readable from
+        // SYCL kernels, which jump just like the host
+        static const jump_table jump_table_;
+
+        static constexpr jump_table make_jump_table()
+        {
+            jump_table table{};
+
+            for (int k = 0; k < 16; ++k)
+            {
+                table.pow[k][0] = 1;
+                table.pow[k][1] = k == 0 ? a : mul_mod64(table.pow[k - 1][15], table.pow[k - 1][1], m);
+
+                for (int d = 2; d < 16; ++d)
+                    table.pow[k][d] = mul_mod64(table.pow[k][d - 1], table.pow[k][1], m);
+            }
+
+            return table;
+        }
+
+        // A^e mod M from at most 16 modular multiplications
+        static std::uint64_t pow_a(std::uint64_t e)
+        {
+            std::uint64_t r = jump_table_.pow[0][e & 15];
+
+            for (int k = 1; k < 16; ++k)
+                if ((e >> (4 * k)) & 15) r = mul_mod64(r, jump_table_.pow[k][(e >> (4 * k)) & 15], m);
+
+            return r;
+        }
+
+        inline void set_state(std::uint64_t x_)
+        {
+            x = static_cast<std::uint32_t>(x_ / a);
+            c = static_cast<std::uint32_t>(x_ % a);
+        }
+
+        static inline void next_state(result_type& x_, result_type& c_)
         {
 #ifdef __SYCL_DEVICE_ONLY__
-            std::uint32_t xn = a * x + c;
-            std::uint32_t carry = static_cast<std::uint32_t>(xn < c); // The (Xn<C) will be zero or one for scalar
-            std::uint32_t cn = cl::sycl::mad_hi(a, x, carry);
+            std::uint32_t xn = a * x_ + c_;
+            std::uint32_t carry = static_cast<std::uint32_t>(xn < c_); // The (Xn<C) will be zero or one for scalar
+            std::uint32_t cn = cl::sycl::mad_hi(a, x_, carry);
 
-            x = xn;
-            c = cn;
+            x_ = xn;
+            c_ = cn;
 #else
-            *reinterpret_cast<std::uint64_t*>(this) = x * static_cast<std::uint64_t>(a) + c;
+            std::uint64_t tmp = x_ * static_cast<std::uint64_t>(a) + c_;
+
+            x_ = static_cast<std::uint32_t>(tmp);
+            c_ = static_cast<std::uint32_t>(tmp >> 32);
 #endif
         }
 
-        std::uint64_t add_mod64(std::uint64_t a_,
+        static constexpr std::uint64_t add_mod64(std::uint64_t a_,
                                 std::uint64_t b_,
                                 std::uint64_t M_)
         {
@@ -110,10 +276,13 @@ namespace prng
             return v_;
         }
 
-        std::uint64_t mul_mod64(std::uint64_t a_,
+        static constexpr std::uint64_t mul_mod64(std::uint64_t a_,
                                 std::uint64_t b_,
                                 std::uint64_t M_)
         {
+#if defined(__SIZEOF_INT128__) && !defined(__SYCL_DEVICE_ONLY__)
+            return static_cast<std::uint64_t>(static_cast<unsigned __int128>(a_) * b_ % M_);
+#else
             std::uint64_t r_ = 0;
             while (a_ != 0) {
                 if (a_ & 1)
@@ -122,9 +291,34 @@ namespace prng
                 a_ = a_ >> 1;
             }
             return r_;
+#endif
+        }
+
+        // 2^96 mod M, compensating the A^3 introduced by mul_mod_m
+        static const std::uint64_t mul_shift;
+
+        // x * y * A^3 mod M, for x, y < M. As M = A * 2^32 - 1, A is the
+        // inverse of 2^32, so folding the low 32 bits of a product onto its
+        // high bits, p / 2^32 + (p mod 2^32) * A = p * A mod M, shortens it by
+        // 32 bits without a 128-bit division. Three folds bring x * y < 2^128
+        // below 2^64, one subtraction below M.
+        static std::uint64_t mul_mod_m(std::uint64_t x_, std::uint64_t y_)
+        {
+            std::uint64_t hi, lo;
+            detail::mul_wide(x_, y_, hi, lo);
+
+            for (int i = 0; i < 3; ++i)
+            {
+                const std::uint64_t t = (lo & 0xffffffff) * a;
+
+                lo = (hi << 32 | lo >> 32) + t;
+                hi = (hi >> 32) + (lo < t);
+            }
+
+            return lo >= m ? lo - m : lo;
         }
 
-        std::uint64_t pow_mod64(std::uint64_t a_,
+        static constexpr std::uint64_t pow_mod64(std::uint64_t a_,
                                 std::uint64_t e_,
                                 std::uint64_t M_)
         {
@@ -138,10 +332,10 @@ namespace prng
             return acc_;
         }
 
-        std::array<std::uint32_t, 2> skip_impl_mod64(std::array<std::uint32_t, 2> curr_,
-                                                     std::uint64_t distance_)
+        static std::array<std::uint32_t, 2> skip_impl_mod64(std::array<std::uint32_t, 2> curr_,
+                                                            std::uint64_t distance_)
         {
-            std::uint64_t m_ = pow_mod64(a, distance_, m);
+            std::uint64_t m_ = pow_a(distance_);
             std::uint64_t x = curr_[0]*(std::uint64_t)a + curr_[1];
             x = mul_mod64(x, m_, m);
             return { (std::uint32_t)(x / a),
@@ -149,5 +343,13 @@ namespace prng
         }
     };
 
+    template <std::uint32_t A, std::uint64_t M>
+    constexpr typename multiply_with_carry_engine_32<A, M>::jump_table multiply_with_carry_engine_32<A, M>::jump_table_ =
+        multiply_with_carry_engine_32<A, M>::make_jump_table();
+
+    template <std::uint32_t A, std::uint64_t M>
+    constexpr std::uint64_t multiply_with_carry_engine_32<A, M>::mul_shift =
+        multiply_with_carry_engine_32<A, M>::mul_mod64((0 - M) % M, std::uint64_t{ 1 } << 32, M);
+
     using mwc64x_32 = multiply_with_carry_engine_32<4294883355u, 18446383549859758079ul>;
 }
\ No newline at end of file
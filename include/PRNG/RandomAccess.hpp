@@ -0,0 +1,123 @@
+// Copyright(c) 2018 Mt Ferenc Nagy-Egri, Wigner GPU-Laboratory.
+//
+// All rights reserved.
+//
+// The 3-clause BSD License is applied to this software, see LICENSE.txt
+//
+
+#pragma once
+
+namespace prng
+{
+    // Answers Engine::value_at queries on a single seeded stream. Queries
+    // shortly ahead of the last one only step the engine. Checkpoints of
+    // the stream recorded on the way make queries shortly behind it
+    // (rollbacks) cheap as well. Any other query jumps via Engine::state_at.
+    //
+    // Standard layout and free of dynamic memory, usable inside SYCL kernels.
+    // Each checkpoint holds a copy of the engine, hence the default keeps few.
+    template <typename Engine, unsigned Checkpoints = 4>
+    class random_access
+    {
+    public:
+
+        using result_type = typename Engine::result_type;
+
+        // Distances up to which stepping forward beats Engine::state_at,
+        // which jumps from this distance on
+        static constexpr unsigned long long window = Engine::discard_threshold;
+
+        // Number and spacing of the checkpoints, covering window values
+        // behind the last query
+        static constexpr unsigned checkpoints = Checkpoints;
+        static constexpr unsigned long long checkpoint_interval = window / checkpoints;
+
+        static_assert(0 < checkpoints && checkpoints <= window, "Checkpoints must be in [1, Engine::discard_threshold].");
+
+        explicit random_access(result_type seed)
+            : seed_(seed)
+            , index_(0)
+            , engine_(seed)
+            , count_(0)
+            , newest_(0)
+        {
+            record();
+        }
+
+        // Engine seeded with seed() that has already produced index values
+        Engine state_at(unsigned long long index)
+        {
+            seek(index);
+
+            return engine_;
+        }
+
+        // The index-th value of the stream seeded with seed()
+        result_type value_at(unsigned long long index)
+        {
+            seek(index);
+            ++index_;
+
+            return engine_();
+        }
+
+        result_type seed() const { return seed_; }
+
+    private:
+
+        result_type seed_;
+        unsigned long long index_;
+        Engine engine_;
+
+        // Ring of checkpoints in increasing index order, newest_ the last
+        Engine checkpoint_engine_[checkpoints];
+        unsigned long long checkpoint_index_[checkpoints];
+        unsigned count_, newest_;
+
+        void record()
+        {
+            newest_ = (newest_ + 1) % checkpoints;
+            checkpoint_engine_[newest_] = engine_;
+            checkpoint_index_[newest_] = index_;
+
+            if (count_ < checkpoints) ++count_;
+        }
+
+        void seek(unsigned long long index)
+        {
+            if (index < index_ || index - index_ >= window)
+            {
+                // Newest checkpoint at or below index
+                unsigned k = 0, slot = newest_;
+                for (; k < count_ && checkpoint_index_[slot] > index; ++k)
+                    slot = (slot + checkpoints - 1) % checkpoints;
+
+                if (k < count_ && index - checkpoint_index_[slot] < window)
+                {
+                    engine_ = checkpoint_engine_[slot];
+                    index_ = checkpoint_index_[slot];
+                }
+                else
+                {
+                    engine_ = Engine::state_at(seed_, index);
+                    index_ = index;
+
+                    count_ = 0;
+                    record();
+                }
+            }
+
+            // Steps in runs up to the next checkpoint, all below window
+            while (index_ < index)
+            {
+                const unsigned long long next = checkpoint_index_[newest_] + checkpoint_interval,
+                                         stop = index < next ? index : next;
+
+                engine_.discard(stop - index_);
+                index_ = stop;
+
+                if (index_ == next) record();
+            }
+        }
+    };
+}
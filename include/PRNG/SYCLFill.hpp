@@ -0,0 +1,237 @@
+// Copyright(c) 2018 Mt Ferenc Nagy-Egri, Wigner GPU-Laboratory.
+//
+// All rights reserved.
+//
+// The 3-clause BSD License is applied to this software, see LICENSE.txt
+//
+
+#pragma once
+
+// SYCL-PRNG includes
+#include <PRNG/Fill.hpp>
+
+// SYCL includes
+#include <CL/sycl.hpp>
+
+// Standard C++ includes
+#include <cstddef>      // std::size_t
+#include <algorithm>    // std::min, std::max
+#include <stdexcept>    // std::out_of_range
+
+namespace prng
+{
+    namespace sycl
+    {
+        namespace detail
+        {
+            // Bits of work-item indices, bounding the number of work-items
+            constexpr unsigned fill_item_bits = 24;
+
+            // Work-items generating per_item consecutive values each
+            struct fill_launch
+            {
+                std::size_t local, global, per_item;
+            };
+
+            // Fills a work-group per compute unit several times over on GPUs
+            // to hide latency and a single one per unit elsewhere, handing
+            // each work-item at least min_per_item values, a multiple of
+            // granule, to amortize its jump ahead.
+            inline fill_launch tune_fill(const ::cl::sycl::device& dev, std::size_t n, std::size_t granule, std::size_t min_per_item)
+            {
+                const bool gpu = dev.is_gpu();
+
+                const std::size_t local = std::min<std::size_t>(dev.get_info<::cl::sycl::info::device::max_work_group_size>(), gpu ? 256 : 16),
+                                  units = std::max<std::size_t>(dev.get_info<::cl::sycl::info::device::max_compute_units>(), 1),
+                                  items = std::min<std::size_t>(units * local * (gpu ? 4 : 1), std::size_t{ 1 } << fill_item_bits);
+
+                std::size_t per_item = std::max((n + items - 1) / items, min_per_item);
+                per_item = (per_item + granule - 1) / granule * granule;
+
+                const std::size_t used = (n + per_item - 1) / per_item;
+
+                return { local, (used + local - 1) / local * local, per_item };
+            }
+
+            // Starting state of every work-item, an engine seeded on the host
+            // jumped ahead by distance times the work-item's index. The jumps
+            // by distance * 2^k are built once on the host, so work-items only
+            // apply them instead of each computing its own jump polynomial.
+            template <typename Engine>
+            struct fill_origin
+            {
+                Engine engine;
+                typename Engine::jump_ahead jumps[fill_item_bits];
+
+                Engine at(std::size_t item) const
+                {
+                    Engine result = engine;
+
+                    for (unsigned k = 0; (item >> k) != 0; ++k)
+                        if ((item >> k) & 1) jumps[k](result);
+
+                    return result;
+                }
+            };
+
+            template <typename Engine>
+            fill_origin<Engine> make_fill_origin(typename Engine::result_type seed, unsigned long long distance, std::size_t items)
+            {
+                fill_origin<Engine> origin{ Engine{ seed } };
+
+                for (unsigned k = 0; ((items - 1) >> k) != 0; ++k)
+                    origin.jumps[k] = typename Engine::jump_ahead{ distance << k };
+
+                return origin;
+            }
+
+            template <typename Engine, typename Output>
+            struct fill_kernel
+            {
+                Output out;
+                std::size_t n, per_item;
+                fill_origin<Engine> origin;
+
+                void operator()(::cl::sycl::nd_item<1> item) const
+                {
+                    const std::size_t first = item.get_global_id(0) * per_item;
+
+                    if (first >= n) return;
+
+                    const std::size_t last = n - first < per_item ? n : first + per_item;
+
+                    Engine engine = origin.at(item.get_global_id(0));
+
+                    for (std::size_t i = first; i < last; ++i) out[i] = engine();
+                }
+            };
+
+            // Each work-item generates per_item / prng::detail::fill_block
+            // consecutive blocks, jumping between their substreams.
+            template <typename Engine, typename Distribution, typename Output>
+            struct fill_distribution_kernel
+            {
+                Output out;
+                std::size_t n, per_item;
+                fill_origin<Engine> origin;
+                typename Engine::jump_ahead next_block;
+                Distribution dist;
+
+                void operator()(::cl::sycl::nd_item<1> item) const
+                {
+                    const std::size_t first = item.get_global_id(0) * per_item;
+
+                    if (first >= n) return;
+
+                    const std::size_t last = n - first < per_item ? n : first + per_item;
+
+                    Engine block = origin.at(item.get_global_id(0));
+
+                    for (std::size_t b = first; b < last; b += prng::detail::fill_block)
+                    {
+                        Engine engine = block;
+                        Distribution d = dist;
+
+                        for (std::size_t i = b; i < last && i < b + prng::detail::fill_block; ++i) out[i] = d(engine);
+
+                        next_block(block);
+                    }
+                }
+            };
+
+            template <typename T>
+            void check_size(const ::cl::sycl::buffer<T, 1>& out, std::size_t n)
+            {
+                if (n > out.get_count()) throw std::out_of_range{ "Fill exceeds the size of the buffer." };
+            }
+
+            template <typename Engine, typename Output>
+            fill_kernel<Engine, Output> make_fill_kernel(::cl::sycl::queue& queue, std::size_t n, typename Engine::result_type seed, Output out, fill_launch& launch)
+            {
+                launch = tune_fill(queue.get_device(), n, 1, 256);
+
+                return { out, n, launch.per_item, make_fill_origin<Engine>(seed, launch.per_item, launch.global) };
+            }
+
+            template <typename Engine, typename Distribution, typename Output>
+            fill_distribution_kernel<Engine, Distribution, Output> make_fill_distribution_kernel(::cl::sycl::queue& queue, std::size_t n, typename Engine::result_type seed, const Distribution& dist, Output out, fill_launch& launch)
+            {
+                launch = tune_fill(queue.get_device(), n, prng::detail::fill_block, prng::detail::fill_block);
+
+                const unsigned long long block_distance = 1ull << prng::detail::fill_substream_log2;
+
+                return { out, n, launch.per_item,
+                         make_fill_origin<Engine>(seed, launch.per_item / prng::detail::fill_block * block_distance, launch.global),
+                         typename Engine::jump_ahead{ block_distance }, dist };
+            }
+        }
+
+        // Fills out[0, n) with the first n values of Engine{ seed }, exactly
+        // like the host reference prng::fill. Work-items generate runs of
+        // consecutive values, with the launch configuration derived from the
+        // device of queue.
+        template <typename Engine, typename T>
+        ::cl::sycl::event fill(::cl::sycl::queue& queue, ::cl::sycl::buffer<T, 1>& out, std::size_t n, typename Engine::result_type seed)
+        {
+            detail::check_size(out, n);
+
+            if (n == 0) return ::cl::sycl::event{};
+
+            return queue.submit([&](::cl::sycl::handler& cgh)
+            {
+                auto acc = out.template get_access<::cl::sycl::access::mode::discard_write>(cgh);
+
+                detail::fill_launch launch;
+                auto kernel = detail::make_fill_kernel<Engine>(queue, n, seed, acc, launch);
+
+                cgh.parallel_for(::cl::sycl::nd_range<1>{ launch.global, launch.local }, kernel);
+            });
+        }
+
+        // Fills out[0, n) with values of dist, exactly like the host reference
+        // prng::fill_distribution. Distribution must be usable in kernels.
+        template <typename Engine, typename T, typename Distribution>
+        ::cl::sycl::event fill_distribution(::cl::sycl::queue& queue, ::cl::sycl::buffer<T, 1>& out, std::size_t n, typename Engine::result_type seed, const Distribution& dist)
+        {
+            detail::check_size(out, n);
+
+            if (n == 0) return ::cl::sycl::event{};
+
+            return queue.submit([&](::cl::sycl::handler& cgh)
+            {
+                auto acc = out.template get_access<::cl::sycl::access::mode::discard_write>(cgh);
+
+                detail::fill_launch launch;
+                auto kernel = detail::make_fill_distribution_kernel<Engine>(queue, n, seed, dist, acc, launch);
+
+                cgh.parallel_for(::cl::sycl::nd_range<1>{ launch.global, launch.local }, kernel);
+            });
+        }
+
+#if defined(SYCL_LANGUAGE_VERSION) && SYCL_LANGUAGE_VERSION >= 202001
+        // USM counterparts, out pointing to at least n elements of device or
+        // shared memory.
+        template <typename Engine, typename T>
+        ::cl::sycl::event fill(::cl::sycl::queue& queue, T* out, std::size_t n, typename Engine::result_type seed)
+        {
+            if (n == 0) return ::cl::sycl::event{};
+
+            detail::fill_launch launch;
+            auto kernel = detail::make_fill_kernel<Engine>(queue, n, seed, out, launch);
+
+            return queue.parallel_for(::cl::sycl::nd_range<1>{ launch.global, launch.local }, kernel);
+        }
+
+        template <typename Engine, typename T, typename Distribution>
+        ::cl::sycl::event fill_distribution(::cl::sycl::queue& queue, T* out, std::size_t n, typename Engine::result_type seed, const Distribution& dist)
+        {
+            if (n == 0) return ::cl::sycl::event{};
+
+            detail::fill_launch launch;
+            auto kernel = detail::make_fill_distribution_kernel<Engine>(queue, n, seed, dist, out, launch);
+
+            return queue.parallel_for(::cl::sycl::nd_range<1>{ launch.global, launch.local }, kernel);
+        }
+#endif
+    }
+}
@@ -11,6 +11,7 @@
 
 // SYCL-PRNG includes
 #include <PRNG/concepts/SeedSequence.hpp>
+#include <PRNG/detail/F2Polynomial.hpp>
 
 // Standard C++ includes
 #include <cstddef>  // std::size_t
@@ -49,23 +50,141 @@ namespace prng
             state_[1] = mat2 ^ tmat;
 
             for (int i = 1; i < min_loop; i++)
-            {
-                state_[i & 1] ^=
-                    i + static_cast<result_type>(6364136223846793005) *
-                    (state_[(i - 1) & 1] ^ (state_[(i - 1) & 1] >> 62));
-            }
+                init_step(i, state_[i & 1], state_[(i - 1) & 1]);
         }
         //template <typename Sseq, typename std::enable_if<concepts::SeedSequence<Sseq> and not concepts::ConvertibleTo<Sseq, result_type>, tiny_mersenne_twister_engine_64>::type = 0>
         //void seed(Sseq& s) { s.generate(state_, state_ + state_size); }
 
         result_type operator()()
         {
-            next_state();
+            next_state(state_[0], state_[1]);
+
+            return temper(state_[0], state_[1]);
+        }
+
+        // Distances below which discard steps instead of jumping
+        static constexpr unsigned long long discard_threshold = 256;
+
+        void discard(unsigned long long z)
+        {
+            if (z < discard_threshold)
+                for (; 0 < z; --z) next_state(state_[0], state_[1]);
+            else
+                jump_ahead{ z }(*this);
+        }
+
+        // Engine seeded with seed that has already produced index values
+        static tiny_mersenne_twister_engine_64 state_at(result_type seed, unsigned long long index)
+        {
+            tiny_mersenne_twister_engine_64 engine{ seed };
+            engine.discard(index);
+            return engine;
+        }
+
+        // The index-th value produced by an engine seeded with seed
+        static result_type value_at(result_type seed, unsigned long long index)
+        {
+            return state_at(seed, index)();
+        }
+
+        // Advances engines by a fixed distance. Construction computes the jump
+        // polynomial, after which each application costs O(state bits) steps.
+        class jump_ahead
+        {
+        public:
+
+            explicit jump_ahead(unsigned long long z)
+                : poly_(z < step_threshold ? detail::f2_polynomial{} : jump_table_.power(z - 1))
+                , z_(z)
+            {}
+
+            // Jump by zero
+            jump_ahead() : poly_{}, z_(0) {}
+
+            void operator()(tiny_mersenne_twister_engine_64& engine) const
+            {
+                if (z_ < step_threshold)
+                    for (unsigned long long i = 0; i < z_; ++i) next_state(engine.state_[0], engine.state_[1]);
+                else
+                    engine.jump(poly_);
+            }
+
+        private:
+
+            detail::f2_polynomial poly_;
+            unsigned long long z_;
+        };
+
+        // Seeds n engines at once, yielding the same states as constructing
+        // out[i] from seeds[i]. Engines are processed in blocks of simd_lanes
+        // held as structure-of-arrays, so the recurrence vectorizes across lanes.
+        template <typename Seed>
+        static void seed_n(tiny_mersenne_twister_engine_64* out, const Seed* seeds, std::size_t n)
+        {
+            for (std::size_t b = 0; b < n; b += simd_lanes)
+            {
+                const std::size_t w = n - b < simd_lanes ? n - b : simd_lanes;
+
+                result_type s[state_size][simd_lanes];
 
-            return temper();
+                for (std::size_t l = 0; l < simd_lanes; ++l)
+                {
+                    s[0][l] = static_cast<result_type>(l < w ? seeds[b + l] : 0) ^ ((result_type)mat1 << 32);
+                    s[1][l] = mat2 ^ tmat;
+                }
+
+                for (int i = 1; i < min_loop; i++)
+                    for (std::size_t l = 0; l < simd_lanes; ++l)
+                        init_step(i, s[i & 1][l], s[(i - 1) & 1][l]);
+
+                for (std::size_t l = 0; l < w; ++l)
+                {
+                    out[b + l].state_[0] = s[0][l];
+                    out[b + l].state_[1] = s[1][l];
+                }
+            }
         }
 
-        void discard(unsigned long long z) { for (; 0 < z; --z) (*this)(); }
+        // Advances count engines per_engine times each, writing the outputs of
+        // engines[i] to out[i * per_engine, (i + 1) * per_engine).
+        static void generate_n(tiny_mersenne_twister_engine_64* engines, std::size_t count,
+                               result_type* out, std::size_t per_engine)
+        {
+            for (std::size_t b = 0; b < count; b += simd_lanes)
+            {
+                const std::size_t w = count - b < simd_lanes ? count - b : simd_lanes;
+
+                result_type s[state_size][simd_lanes];
+
+                for (std::size_t l = 0; l < simd_lanes; ++l)
+                    for (std::size_t k = 0; k < state_size; ++k)
+                        s[k][l] = engines[b + (l < w ? l : 0)].state_[k];
+
+                // Outputs are gathered into a tile, so that each lane stores
+                // contiguous runs instead of striding through memory per value.
+                for (std::size_t i = 0; i < per_engine; i += simd_lanes)
+                {
+                    const std::size_t h = per_engine - i < simd_lanes ? per_engine - i : simd_lanes;
+
+                    result_type r[simd_lanes][simd_lanes];
+
+                    for (std::size_t k = 0; k < h; ++k)
+                        for (std::size_t l = 0; l < simd_lanes; ++l)
+                        {
+                            next_state(s[0][l], s[1][l]);
+                            r[k][l] = temper(s[0][l], s[1][l]);
+                        }
+
+                    for (std::size_t l = 0; l < w; ++l)
+                        for (std::size_t k = 0; k < h; ++k)
+                            out[(b + l) * per_engine + i + k] = r[k][l];
+                }
+
+                for (std::size_t l = 0; l < w; ++l)
+                    for (std::size_t k = 0; k < state_size; ++k)
+                        engines[b + l].state_[k] = s[k][l];
+            }
+        }
 
         friend bool operator==(const tiny_mersenne_twister_engine_64<Mat1, Mat2, TMat>& lhs,
             const tiny_mersenne_twister_engine_64<Mat1, Mat2, TMat>& rhs)
@@ -95,28 +214,79 @@ namespace prng
 
         // Non-customizable params
         static constexpr int min_loop = 8;
+        static constexpr std::size_t simd_lanes = 16;
+
+        static inline void init_step(int i, result_type& curr, result_type prev)
+        {
+            curr ^= i + static_cast<result_type>(6364136223846793005) * (prev ^ (prev >> 62));
+        }
+
+        // Below this distance stepping is cheaper than applying a precomputed
+        // polynomial, which takes about twice its degree in steps
+        static constexpr unsigned long long step_threshold = 256;
 
-        inline void next_state()
+        // Const and constant initialized, hence readable from SYCL kernels,
+        // which jump just like the host
+        static const detail::f2_jump_table jump_table_;
+
+        // The masked bit makes the transition singular, so the characteristic
+        // polynomial only annihilates states that have been stepped at least once.
+        static constexpr detail::f2_jump_table make_jump_table()
         {
-            state_[0] &= mask;
+            result_type s[state_size] = { default_seed ^ ((result_type)mat1 << 32), mat2 ^ tmat };
+            detail::f2_sequence seq{};
+
+            for (int i = 0; i < detail::f2_sequence::size; ++i)
+            {
+                next_state(s[0], s[1]);
+                seq.set(i, s[1] & 1);
+            }
+
+            return detail::make_f2_jump_table(seq);
+        }
+
+        // Computes poly(T) applied to T(state), where T is next_state
+        void jump(const detail::f2_polynomial& poly)
+        {
+            next_state(state_[0], state_[1]);
+
+            result_type work[state_size] = {};
 
-            result_type x = state_[0] ^ state_[1];
+            for (int i = 0; i < jump_table_.degree; ++i)
+            {
+                const result_type add = 0 - static_cast<result_type>(poly.coefficient(i));
+
+                work[0] ^= state_[0] & add;
+                work[1] ^= state_[1] & add;
+
+                next_state(state_[0], state_[1]);
+            }
+
+            state_[0] = work[0];
+            state_[1] = work[1];
+        }
+
+        static constexpr void next_state(result_type& s0, result_type& s1)
+        {
+            s0 &= mask;
+
+            result_type x = s0 ^ s1;
             x ^= x << sh0;
             x ^= x >> 32;
             x ^= x << 32;
             x ^= x << sh1;
 
-            state_[0] = state_[1];
-            state_[1] = x;
+            s0 = s1;
+            s1 = x;
 
-            state_[0] ^= -((std::int64_t)(x & 1)) & mat1;
-            state_[1] ^= -((std::int64_t)(x & 1)) & (((result_type)mat2) << 32);
+            s0 ^= -((std::int64_t)(x & 1)) & mat1;
+            s1 ^= -((std::int64_t)(x & 1)) & (((result_type)mat2) << 32);
         }
-        inline result_type temper()
+        static inline result_type temper(result_type s0, result_type s1)
         {
-            uint64_t x = state_[0] + state_[1];
+            uint64_t x = s0 + s1;
 
-            x ^= state_[0] >> sh8;
+            x ^= s0 >> sh8;
             x ^= -((std::int64_t)(x & 1)) & tmat;
 
             return x;
@@ -139,7 +309,14 @@ namespace prng
 
         static constexpr result_type default_seed = 5489u;
 
-        tiny_mersenne_twister_engine_32(result_type value)
+        tiny_mersenne_twister_engine_32(result_type value) { seed(value); }
+
+        //template <typename Sseq> explicit tiny_mersenne_twister_engine_32(Sseq& s);
+
+        tiny_mersenne_twister_engine_32() : tiny_mersenne_twister_engine_32(default_seed) {}
+        tiny_mersenne_twister_engine_32(const tiny_mersenne_twister_engine_32&) = default;
+
+        void seed(result_type value = default_seed)
         {
             state_[0] = value;
             state_[1] = mat1;
@@ -147,30 +324,147 @@ namespace prng
             state_[3] = tmat;
 
             for (int i = 1; i < min_loop; i++)
-            {
-                state_[i & 3] ^= i + UINT32_C(1812433253) *
-                    (state_[(i - 1) & 3] ^ (state_[(i - 1) & 3] >> 30));
-            }
+                init_step(i, state_[i & 3], state_[(i - 1) & 3]);
 
-            for (int i = 0; i < pre_loop; i++) next_state();
+            for (int i = 0; i < pre_loop; i++)
+                next_state(state_[0], state_[1], state_[2], state_[3]);
         }
+        //template <typename Sseq> void seed(Sseq& s);
 
-        //template <typename Sseq> explicit tiny_mersenne_twister_engine_32(Sseq& s);
+        result_type operator()()
+        {
+            next_state(state_[0], state_[1], state_[2], state_[3]);
 
-        tiny_mersenne_twister_engine_32() : tiny_mersenne_twister_engine_32(default_seed) {}
-        tiny_mersenne_twister_engine_32(const tiny_mersenne_twister_engine_32&) = default;
+            return temper(state_[0], state_[2], state_[3]);
+        }
 
-        void seed(result_type value = default_seed);
-        //template <typename Sseq> void seed(Sseq& s);
+        // Distances below which discard steps instead of jumping
+        static constexpr unsigned long long discard_threshold = 256;
 
-        result_type operator()()
+        void discard(unsigned long long z)
+        {
+            if (z < discard_threshold)
+                for (; 0 < z; --z) next_state(state_[0], state_[1], state_[2], state_[3]);
+            else
+                jump_ahead{ z }(*this);
+        }
+
+        // Engine seeded with seed that has already produced index values
+        static tiny_mersenne_twister_engine_32 state_at(result_type seed, unsigned long long index)
+        {
+            tiny_mersenne_twister_engine_32 engine{ seed };
+            engine.discard(index);
+            return engine;
+        }
+
+        // The index-th value produced by an engine seeded with seed
+        static result_type value_at(result_type seed, unsigned long long index)
+        {
+            return state_at(seed, index)();
+        }
+
+        // Advances engines by a fixed distance. Construction computes the jump
+        // polynomial, after which each application costs O(state bits) steps.
+        class jump_ahead
+        {
+        public:
+
+            explicit jump_ahead(unsigned long long z)
+                : poly_(z < step_threshold ? detail::f2_polynomial{} : jump_table_.power(z - 1))
+                , z_(z)
+            {}
+
+            // Jump by zero
+            jump_ahead() : poly_{}, z_(0) {}
+
+            void operator()(tiny_mersenne_twister_engine_32& engine) const
+            {
+                if (z_ < step_threshold)
+                    for (unsigned long long i = 0; i < z_; ++i) next_state(engine.state_[0], engine.state_[1], engine.state_[2], engine.state_[3]);
+                else
+                    engine.jump(poly_);
+            }
+
+        private:
+
+            detail::f2_polynomial poly_;
+            unsigned long long z_;
+        };
+
+        // Seeds n engines at once, yielding the same states as constructing
+        // out[i] from seeds[i]. Both the init and the pre-loop run on blocks
+        // of simd_lanes engines held as structure-of-arrays.
+        template <typename Seed>
+        static void seed_n(tiny_mersenne_twister_engine_32* out, const Seed* seeds, std::size_t n)
         {
-            next_state();
+            for (std::size_t b = 0; b < n; b += simd_lanes)
+            {
+                const std::size_t w = n - b < simd_lanes ? n - b : simd_lanes;
+
+                result_type s[state_size][simd_lanes];
+
+                for (std::size_t l = 0; l < simd_lanes; ++l)
+                {
+                    s[0][l] = static_cast<result_type>(l < w ? seeds[b + l] : 0);
+                    s[1][l] = mat1;
+                    s[2][l] = mat2;
+                    s[3][l] = tmat;
+                }
+
+                for (int i = 1; i < min_loop; i++)
+                    for (std::size_t l = 0; l < simd_lanes; ++l)
+                        init_step(i, s[i & 3][l], s[(i - 1) & 3][l]);
 
-            return temper();
+                for (int i = 0; i < pre_loop; i++)
+                    for (std::size_t l = 0; l < simd_lanes; ++l)
+                        next_state(s[0][l], s[1][l], s[2][l], s[3][l]);
+
+                for (std::size_t l = 0; l < w; ++l)
+                    for (std::size_t k = 0; k < state_size; ++k)
+                        out[b + l].state_[k] = s[k][l];
+            }
         }
 
-        void discard(unsigned long long z) { for (; 0 < z; --z) (*this)(); }
+        // Advances count engines per_engine times each, writing the outputs of
+        // engines[i] to out[i * per_engine, (i + 1) * per_engine).
+        static void generate_n(tiny_mersenne_twister_engine_32* engines, std::size_t count,
+                               result_type* out, std::size_t per_engine)
+        {
+            for (std::size_t b = 0; b < count; b += simd_lanes)
+            {
+                const std::size_t w = count - b < simd_lanes ? count - b : simd_lanes;
+
+                result_type s[state_size][simd_lanes];
+
+                for (std::size_t l = 0; l < simd_lanes; ++l)
+                    for (std::size_t k = 0; k < state_size; ++k)
+                        s[k][l] = engines[b + (l < w ? l : 0)].state_[k];
+
+                // Outputs are gathered into a tile, so that each lane stores
+                // contiguous runs instead of striding through memory per value.
+                for (std::size_t i = 0; i < per_engine; i += simd_lanes)
+                {
+                    const std::size_t h = per_engine - i < simd_lanes ? per_engine - i : simd_lanes;
+
+                    result_type r[simd_lanes][simd_lanes];
+
+                    for (std::size_t k = 0; k < h; ++k)
+                        for (std::size_t l = 0; l < simd_lanes; ++l)
+                        {
+                            next_state(s[0][l], s[1][l], s[2][l], s[3][l]);
+                            r[k][l] = temper(s[0][l], s[2][l], s[3][l]);
+                        }
+
+                    for (std::size_t l = 0; l < w; ++l)
+                        for (std::size_t k = 0; k < h; ++k)
+                            out[(b + l) * per_engine + i + k] = r[k][l];
+                }
+
+                for (std::size_t l = 0; l < w; ++l)
+                    for (std::size_t k = 0; k < state_size; ++k)
+                        engines[b + l].state_[k] = s[k][l];
+            }
+        }
 
         friend bool operator==(const tiny_mersenne_twister_engine_32<Mat1, Mat2, TMat>& lhs,
                                const tiny_mersenne_twister_engine_32<Mat1, Mat2, TMat>& rhs)
@@ -205,26 +499,75 @@ namespace prng
         // Non-customizable params
         static constexpr int min_loop = 8;
         static constexpr int pre_loop = 8;
+        static constexpr std::size_t simd_lanes = 16;
 
-        inline void next_state()
+        static inline void init_step(int i, result_type& curr, result_type prev)
         {
-            result_type x = (state_[0] & mask) ^ state_[1] ^ state_[2],
-                        y = state_[3];
+            curr ^= i + UINT32_C(1812433253) * (prev ^ (prev >> 30));
+        }
+
+        // Below this distance stepping is cheaper than applying a precomputed
+        // polynomial, which takes about twice its degree in steps
+        static constexpr unsigned long long step_threshold = 256;
+
+        // Const and constant initialized, hence readable from SYCL kernels,
+        // which jump just like the host
+        static const detail::f2_jump_table jump_table_;
+
+        // The masked bit makes the transition singular, so the characteristic
+        // polynomial only annihilates states that have been stepped at least once.
+        static constexpr detail::f2_jump_table make_jump_table()
+        {
+            result_type s[state_size] = { default_seed, mat1, mat2, tmat };
+            detail::f2_sequence seq{};
+
+            for (int i = 0; i < detail::f2_sequence::size; ++i)
+            {
+                next_state(s[0], s[1], s[2], s[3]);
+                seq.set(i, s[1] & 1);
+            }
+
+            return detail::make_f2_jump_table(seq);
+        }
+
+        // Computes poly(T) applied to T(state), where T is next_state
+        void jump(const detail::f2_polynomial& poly)
+        {
+            next_state(state_[0], state_[1], state_[2], state_[3]);
+
+            result_type work[state_size] = {};
+
+            for (int i = 0; i < jump_table_.degree; ++i)
+            {
+                const result_type add = 0 - static_cast<result_type>(poly.coefficient(i));
+
+                for (std::size_t k = 0; k < state_size; ++k) work[k] ^= state_[k] & add;
+
+                next_state(state_[0], state_[1], state_[2], state_[3]);
+            }
+
+            for (std::size_t k = 0; k < state_size; ++k) state_[k] = work[k];
+        }
+
+        static constexpr void next_state(result_type& s0, result_type& s1, result_type& s2, result_type& s3)
+        {
+            result_type x = (s0 & mask) ^ s1 ^ s2,
+                        y = s3;
 
             x ^= (x << sh0);
             y ^= (y >> sh0) ^ x;
 
-            state_[0] = state_[1];
-            state_[1] = state_[2];
-            state_[2] = x ^ (y << sh1);
-            state_[3] = y;
-            state_[1] ^= -((std::int32_t)(y & 1)) & mat1;
-            state_[2] ^= -((std::int32_t)(y & 1)) & mat2;
+            s0 = s1;
+            s1 = s2;
+            s2 = x ^ (y << sh1);
+            s3 = y;
+            s1 ^= -((std::int32_t)(y & 1)) & mat1;
+            s2 ^= -((std::int32_t)(y & 1)) & mat2;
         }
-        inline result_type temper()
+        static inline result_type temper(result_type s0, result_type s2, result_type s3)
         {
-            result_type t0 = state_[3],
-                        t1 = state_[0] + (state_[2] >> sh8);
+            result_type t0 = s3,
+                        t1 = s0 + (s2 >> sh8);
 
             t0 ^= t1;
             t0 ^= -((std::int32_t)(t1 & 1)) & tmat;
@@ -233,6 +576,14 @@ namespace prng
         }
     };
 
+    template <std::uint32_t Mat1, std::uint32_t Mat2, std::uint64_t TMat>
+    constexpr detail::f2_jump_table tiny_mersenne_twister_engine_64<Mat1, Mat2, TMat>::jump_table_ =
+        tiny_mersenne_twister_engine_64<Mat1, Mat2, TMat>::make_jump_table();
+
+    template <std::uint32_t Mat1, std::uint32_t Mat2, std::uint32_t TMat>
+    constexpr detail::f2_jump_table tiny_mersenne_twister_engine_32<Mat1, Mat2, TMat>::jump_table_ =
+        tiny_mersenne_twister_engine_32<Mat1, Mat2, TMat>::make_jump_table();
+
     using tinymt_64 = tiny_mersenne_twister_engine_64<0xd02f1a04, 0xfe80ffa0, 0x71126defef7e7ffa>; // tinymt64dc --count 1 1
     using tinymt_32 = tiny_mersenne_twister_engine_32<0xda251b45, 0xfed0ffb5, 0x9b5cf7ff>;         // tinymt32dc --count 1 1
 }
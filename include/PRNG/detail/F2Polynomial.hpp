@@ -0,0 +1,129 @@
+// Copyright(c) 2018 Mt Ferenc Nagy-Egri, Wigner GPU-Laboratory.
+//
+// All rights reserved.
+//
+// The 3-clause BSD License is applied to this software, see LICENSE.txt
+//
+
+#pragma once
+
+// Standard C++ includes
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uint64_t
+
+namespace prng
+{
+    namespace detail
+    {
+        // Polynomial over GF(2) of degree below 128, bit i is the coefficient of x^i
+        struct f2_polynomial
+        {
+            std::uint64_t ar[2];
+
+            constexpr bool coefficient(int i) const { return (ar[i / 64] >> (i % 64)) & 1; }
+        };
+
+        // Bit sequence the minimal polynomial is recovered from
+        struct f2_sequence
+        {
+            static constexpr int size = 256;
+
+            std::uint64_t ar[size / 64];
+
+            constexpr bool get(int i) const { return (ar[i / 64] >> (i % 64)) & 1; }
+            constexpr void set(int i, bool b) { ar[i / 64] |= static_cast<std::uint64_t>(b) << (i % 64); }
+        };
+
+        // Jump-ahead polynomials of a linear recurrence, x^(d * 16^k) mod its
+        // characteristic polynomial for every hex digit d of a 64-bit distance.
+        struct f2_jump_table
+        {
+            f2_polynomial characteristic;
+            int degree;
+            f2_polynomial pow[16][16];
+
+            // (a * b) mod characteristic
+            constexpr f2_polynomial multiply(f2_polynomial a, f2_polynomial b) const
+            {
+                f2_polynomial r{};
+
+                for (int i = 0; i < degree; ++i)
+                {
+                    // Branch-free, the coefficients are essentially random
+                    const std::uint64_t add = 0 - static_cast<std::uint64_t>(a.coefficient(i)),
+                                        carry = 0 - static_cast<std::uint64_t>(b.coefficient(degree - 1));
+
+                    r.ar[0] ^= b.ar[0] & add;
+                    r.ar[1] ^= b.ar[1] & add;
+
+                    b.ar[1] = (b.ar[1] << 1) | (b.ar[0] >> 63);
+                    b.ar[0] = b.ar[0] << 1;
+
+                    b.ar[0] ^= characteristic.ar[0] & carry;
+                    b.ar[1] ^= characteristic.ar[1] & carry;
+                }
+
+                return r;
+            }
+
+            // x^z mod characteristic
+            constexpr f2_polynomial power(unsigned long long z) const
+            {
+                f2_polynomial r = pow[0][z & 15];
+
+                for (int k = 1; k < 16; ++k)
+                    if ((z >> (4 * k)) & 15) r = multiply(r, pow[k][(z >> (4 * k)) & 15]);
+
+                return r;
+            }
+        };
+
+        // Berlekamp-Massey, returns the table for the minimal polynomial of seq
+        constexpr f2_jump_table make_f2_jump_table(const f2_sequence& seq)
+        {
+            // Connection polynomials, c(x) = 1 + c_1 x + ... + c_L x^L
+            f2_sequence c{}, b{};
+            c.ar[0] = b.ar[0] = 1;
+
+            int l = 0, m = 1;
+
+            for (int n = 0; n < f2_sequence::size; ++n)
+            {
+                bool d = seq.get(n);
+                for (int i = 1; i <= l; ++i) d ^= c.get(i) && seq.get(n - i);
+
+                if (!d) { ++m; continue; }
+
+                f2_sequence t = c;
+                for (int i = 0; i + m < f2_sequence::size; ++i)
+                    if (b.get(i)) c.ar[(i + m) / 64] ^= std::uint64_t(1) << ((i + m) % 64);
+
+                if (2 * l <= n)
+                {
+                    l = n + 1 - l;
+                    b = t;
+                    m = 1;
+                }
+                else ++m;
+            }
+
+            // Characteristic polynomial is the reciprocal of c(x)
+            f2_jump_table table{};
+            table.degree = l;
+            for (int i = 0; i <= l; ++i)
+                if (c.get(l - i)) table.characteristic.ar[i / 64] |= std::uint64_t(1) << (i % 64);
+
+            for (int k = 0; k < 16; ++k)
+            {
+                table.pow[k][0].ar[0] = 1;
+                if (k == 0) table.pow[k][1].ar[0] = 2;
+                else table.pow[k][1] = table.multiply(table.pow[k - 1][15], table.pow[k - 1][1]);
+
+                for (int d = 2; d < 16; ++d)
+                    table.pow[k][d] = table.multiply(table.pow[k][d - 1], table.pow[k][1]);
+            }
+
+            return table;
+        }
+    }
+}
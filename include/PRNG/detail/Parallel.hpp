@@ -0,0 +1,44 @@
+// Copyright(c) 2018 Mt Ferenc Nagy-Egri, Wigner GPU-Laboratory.
+//
+// All rights reserved.
+//
+// The 3-clause BSD License is applied to this software, see LICENSE.txt
+//
+
+#pragma once
+
+// Standard C++ includes
+#include <cstddef>  // std::size_t
+#include <atomic>   // std::atomic
+#include <thread>   // std::thread
+#include <vector>   // std::vector
+
+namespace prng
+{
+    namespace detail
+    {
+        // Calls f(b) for every block b in [0, blocks) on up to threads threads,
+        // 0 meaning all cores. Blocks are handed out dynamically, so results
+        // must only depend on the block index, never on the executing thread.
+        template <typename F>
+        void parallel_for(std::size_t blocks, unsigned threads, F f)
+        {
+            if (threads == 0) threads = std::thread::hardware_concurrency();
+            if (threads > blocks) threads = static_cast<unsigned>(blocks);
+
+            std::atomic<std::size_t> next{ 0 };
+
+            auto worker = [&]()
+            {
+                for (std::size_t b = next++; b < blocks; b = next++) f(b);
+            };
+
+            std::vector<std::thread> pool;
+            for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+
+            worker();
+
+            for (auto& thread : pool) thread.join();
+        }
+    }
+}
@@ -0,0 +1,113 @@
+// Copyright(c) 2018 Mt Ferenc Nagy-Egri, Wigner GPU-Laboratory.
+//
+// All rights reserved.
+//
+// The 3-clause BSD License is applied to this software, see LICENSE.txt
+//
+
+#pragma once
+
+// Standard C++ includes
+#include <cstdint>  // std::uint64_t
+
+namespace prng
+{
+    namespace detail
+    {
+        // 128-bit product of a and b, split into its high and low words
+        inline void mul_wide(std::uint64_t a, std::uint64_t b, std::uint64_t& hi, std::uint64_t& lo)
+        {
+#if defined(__SIZEOF_INT128__) && !defined(__SYCL_DEVICE_ONLY__)
+            const unsigned __int128 p = static_cast<unsigned __int128>(a) * b;
+
+            hi = static_cast<std::uint64_t>(p >> 64);
+            lo = static_cast<std::uint64_t>(p);
+#else
+            const std::uint64_t a_lo = a & 0xffffffff, a_hi = a >> 32,
+                                b_lo = b & 0xffffffff, b_hi = b >> 32;
+
+            const std::uint64_t ll = a_lo * b_lo,
+                                lh = a_lo * b_hi,
+                                hl = a_hi * b_lo,
+                                hh = a_hi * b_hi;
+
+            const std::uint64_t mid = (ll >> 32) + (lh & 0xffffffff) + (hl & 0xffffffff);
+
+            hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+            lo = (mid << 32) | (ll & 0xffffffff);
+#endif
+        }
+
+        // Index of the lowest set bit of x != 0
+        inline unsigned count_trailing_zeros(std::uint64_t x)
+        {
+#if defined(__GNUC__)
+            return static_cast<unsigned>(__builtin_ctzll(x));
+#else
+            unsigned n = 0;
+            for (; (x & 1) == 0; x >>= 1) ++n;
+            return n;
+#endif
+        }
+
+        // 64 uniform bits from an engine with full range 32 or 64-bit output
+        template <typename Engine>
+        std::uint64_t uniform_bits64(Engine& engine)
+        {
+            if (sizeof(typename Engine::result_type) >= sizeof(std::uint64_t))
+                return static_cast<std::uint64_t>(engine());
+
+            const std::uint64_t hi = static_cast<std::uint64_t>(engine());
+
+            return (hi << 32) | static_cast<std::uint64_t>(engine());
+        }
+
+        // Uniform integer in [0, bound), using Lemire's nearly divisionless
+        // method. Bounds up to 2^32 need a single call of a 32-bit engine.
+        template <typename Engine>
+        std::uint64_t uniform_below(Engine& engine, std::uint64_t bound)
+        {
+            if (sizeof(typename Engine::result_type) < sizeof(std::uint64_t) && bound <= 0x100000000)
+            {
+                std::uint64_t m = static_cast<std::uint64_t>(engine()) * bound;
+
+                if ((m & 0xffffffff) < bound)
+                {
+                    const std::uint64_t t = (0x100000000 - bound) % bound;
+                    while ((m & 0xffffffff) < t) m = static_cast<std::uint64_t>(engine()) * bound;
+                }
+
+                return m >> 32;
+            }
+
+            std::uint64_t hi, lo;
+            mul_wide(uniform_bits64(engine), bound, hi, lo);
+
+            if (lo < bound)
+            {
+                const std::uint64_t t = (0 - bound) % bound;
+                while (lo < t) mul_wide(uniform_bits64(engine), bound, hi, lo);
+            }
+
+            return hi;
+        }
+
+        // Uniform integers in [0, b0) and [0, b1) from a single 64-bit draw,
+        // for b0 * b1 < 2^64 (Brackett-Rozinsky, Lemire: batched ranged
+        // random integer generation).
+        template <typename Engine>
+        void uniform_below(Engine& engine, std::uint64_t b0, std::uint64_t b1,
+                           std::uint64_t& r0, std::uint64_t& r1)
+        {
+            const std::uint64_t product = b0 * b1;
+
+            std::uint64_t lo;
+            do
+            {
+                mul_wide(uniform_bits64(engine), b0, r0, lo);
+                mul_wide(lo, b1, r1, lo);
+            }
+            while (lo < product && lo < (0 - product) % product);
+        }
+    }
+}
@@ -0,0 +1,279 @@
+// SYCL-PRNG includes
+#include <PRNG/TinyMT.hpp>
+#include <PRNG/MWC64X.hpp>
+#include <PRNG/Bulk.hpp>
+
+// Standard C++ includes
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <string>
+#include <vector>
+#include <memory>
+#include <limits>
+#include <algorithm>
+#include <future>
+#include <thread>
+#include <iostream>
+#include <stdexcept>
+
+// POSIX includes
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+
+namespace
+{
+    // Values each worker produces at once, also the granularity of jumps
+    constexpr std::size_t chunk_bytes = std::size_t(4) << 20;
+
+    // Engines per chunk, each generating a contiguous slice of it in SIMD lanes
+    constexpr std::size_t lanes = 16;
+
+    // Distance between substreams, in values
+    constexpr unsigned long long substream_log2 = 40;
+
+    // Substreams addressable with -u
+    constexpr unsigned long long max_substream_log2 = 32;
+
+    struct options
+    {
+        std::string engine;
+        unsigned long long seed = 5489u;
+        unsigned long long substream = 0;
+        unsigned long long bytes = 0;       // 0 means unbounded
+        unsigned threads = 0;               // 0 means hardware concurrency
+        std::string output;                 // empty means stdout
+    };
+
+    void usage(std::ostream& os)
+    {
+        os << "Usage: prng-gen ENGINE [options]\n"
+              "\n"
+              "Writes the raw output of ENGINE as native endian words.\n"
+              "\n"
+              "Engines: tinymt_32, tinymt_64, mwc64x_32\n"
+              "\n"
+              "Options:\n"
+              "  -s, --seed N        Seed of the engine (default: 5489)\n"
+              "  -u, --substream N   Skip N * 2^" << substream_log2 << " values ahead, N < 2^" << max_substream_log2 << " (default: 0)\n"
+              "  -n, --bytes N[KMGT] Bytes to write, unbounded if omitted or 0\n"
+              "  -t, --threads N     Generator threads (default: all cores)\n"
+              "  -o, --output FILE   Write to FILE instead of stdout\n"
+              "\n"
+              "Output depends only on ENGINE, seed and substream, never on the thread count.\n";
+    }
+
+    // Decimal, so that leading zeros do not switch to octal
+    unsigned long long parse_number(const std::string& arg)
+    {
+        if (arg.empty() || arg[0] < '0' || arg[0] > '9')
+            throw std::invalid_argument{ "Malformed number " + arg };
+
+        std::size_t pos = 0;
+        unsigned long long value = std::stoull(arg, &pos, 10);
+
+        if (pos + 1 == arg.size())
+        {
+            switch (arg[pos])
+            {
+            case 'T': case 't': value <<= 10; // fallthrough
+            case 'G': case 'g': value <<= 10; // fallthrough
+            case 'M': case 'm': value <<= 10; // fallthrough
+            case 'K': case 'k': value <<= 10; break;
+            default: throw std::invalid_argument{ "Unknown size suffix in " + arg };
+            }
+        }
+        else if (pos != arg.size())
+            throw std::invalid_argument{ "Malformed number " + arg };
+
+        return value;
+    }
+
+    options parse_options(int argc, char* argv[])
+    {
+        options opts;
+
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+
+            auto value = [&]() -> std::string
+            {
+                if (++i == argc) throw std::invalid_argument{ "Missing value for " + arg };
+                return argv[i];
+            };
+
+            if (arg == "-h" || arg == "--help") { usage(std::cout); std::exit(EXIT_SUCCESS); }
+            else if (arg == "-s" || arg == "--seed") opts.seed = parse_number(value());
+            else if (arg == "-u" || arg == "--substream") opts.substream = parse_number(value());
+            else if (arg == "-n" || arg == "--bytes") opts.bytes = parse_number(value());
+            else if (arg == "-t" || arg == "--threads") opts.threads = static_cast<unsigned>(parse_number(value()));
+            else if (arg == "-o" || arg == "--output") opts.output = value();
+            else if (opts.engine.empty() && arg[0] != '-') opts.engine = arg;
+            else throw std::invalid_argument{ "Unknown argument " + arg };
+        }
+
+        if (opts.engine.empty()) throw std::invalid_argument{ "No engine specified." };
+        if (opts.substream >> max_substream_log2 != 0) throw std::invalid_argument{ "Substream out of range." };
+        if (opts.threads == 0) opts.threads = std::max(1u, std::thread::hardware_concurrency());
+
+        return opts;
+    }
+
+    struct aligned_deleter { void operator()(void* p) const { std::free(p); } };
+
+    template <typename T>
+    std::unique_ptr<T[], aligned_deleter> make_aligned_buffer(std::size_t count)
+    {
+        void* p = nullptr;
+        if (posix_memalign(&p, 4096, count * sizeof(T)) != 0) throw std::bad_alloc{};
+        return std::unique_ptr<T[], aligned_deleter>{ static_cast<T*>(p) };
+    }
+
+    // Returns false once the reader went away
+    bool write_all(int fd, const void* data, std::size_t size)
+    {
+        const char* p = static_cast<const char*>(data);
+
+        while (size != 0)
+        {
+            ssize_t written = ::write(fd, p, size);
+
+            if (written < 0)
+            {
+                if (errno == EINTR) continue;
+                if (errno == EPIPE) return false;
+                throw std::runtime_error{ std::string{ "write failed: " } + std::strerror(errno) };
+            }
+
+            p += written;
+            size -= static_cast<std::size_t>(written);
+        }
+
+        return true;
+    }
+
+    // Worker w generates chunks w, w + threads, w + 2 * threads, ... of the
+    // stream, each lane advancing by a precomputed jump between its chunks.
+    // Generation of the next round overlaps writing the previous one.
+    template <typename Engine>
+    void generate(const options& opts, int fd)
+    {
+        using result_type = typename Engine::result_type;
+
+        const std::size_t chunk_values = chunk_bytes / sizeof(result_type),
+                          lane_values = chunk_values / lanes,
+                          threads = opts.threads;
+
+        if (opts.seed > std::numeric_limits<result_type>::max())
+            throw std::invalid_argument{ "Seed does not fit the engine." };
+
+        Engine origin{ static_cast<result_type>(opts.seed) };
+
+        // One jump by 2^(substream_log2 + k) per bit k set in the substream,
+        // composed from jumps by 2^63 where that does not fit a jump_ahead
+        const typename Engine::jump_ahead longest_jump{ 1ull << 63 };
+        for (unsigned long long k = 0; opts.substream >> k != 0; ++k)
+        {
+            if (((opts.substream >> k) & 1) == 0) continue;
+
+            if (substream_log2 + k < 64)
+                typename Engine::jump_ahead{ 1ull << (substream_log2 + k) }(origin);
+            else
+                for (unsigned long long j = 0; j >> (substream_log2 + k - 63) == 0; ++j)
+                    longest_jump(origin);
+        }
+
+        std::vector<Engine> engines;
+        for (std::size_t w = 0; w < threads; ++w)
+            for (std::size_t l = 0; l < lanes; ++l)
+            {
+                engines.push_back(origin);
+                engines.back().discard(w * chunk_values + l * lane_values);
+            }
+
+        const typename Engine::jump_ahead next_round{ threads * chunk_values - lane_values };
+
+        auto buffers = make_aligned_buffer<result_type>(2 * threads * chunk_values);
+        auto round_buffer = [&](unsigned long long r) { return buffers.get() + (r % 2) * threads * chunk_values; };
+
+        const unsigned long long round_bytes = static_cast<unsigned long long>(threads) * chunk_bytes;
+
+        auto bytes_in_round = [&](unsigned long long r)
+        {
+            if (opts.bytes == 0) return round_bytes;
+            const unsigned long long done = r * round_bytes;
+            return done >= opts.bytes ? 0 : std::min(round_bytes, opts.bytes - done);
+        };
+
+        for (unsigned long long r = 0; ; ++r)
+        {
+            const unsigned long long bytes = bytes_in_round(r);
+            const std::size_t chunks = static_cast<std::size_t>((bytes + chunk_bytes - 1) / chunk_bytes);
+
+            std::vector<std::future<void>> workers;
+            for (std::size_t w = 0; w < chunks; ++w)
+                workers.push_back(std::async(std::launch::async, [&, w]()
+                {
+                    Engine* lane_engines = engines.data() + w * lanes;
+
+                    prng::generate_n(lane_engines, lanes, round_buffer(r) + w * chunk_values, lane_values);
+
+                    for (std::size_t l = 0; l < lanes; ++l) next_round(lane_engines[l]);
+                }));
+
+            const bool open = r == 0 || write_all(fd, round_buffer(r - 1), static_cast<std::size_t>(bytes_in_round(r - 1)));
+
+            for (auto& worker : workers) worker.get();
+
+            if (!open) return;
+            if (bytes < round_bytes)
+            {
+                write_all(fd, round_buffer(r), static_cast<std::size_t>(bytes));
+                return;
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        const options opts = parse_options(argc, argv);
+
+        // Broken pipes are reported through EPIPE, ending output quietly
+        ::signal(SIGPIPE, SIG_IGN);
+
+        int fd = STDOUT_FILENO;
+        if (!opts.output.empty())
+        {
+            fd = ::open(opts.output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0) throw std::runtime_error{ "Cannot open " + opts.output + ": " + std::strerror(errno) };
+        }
+
+        if (opts.engine == "tinymt_32") generate<prng::tinymt_32>(opts, fd);
+        else if (opts.engine == "tinymt_64") generate<prng::tinymt_64>(opts, fd);
+        else if (opts.engine == "mwc64x_32") generate<prng::mwc64x_32>(opts, fd);
+        else throw std::invalid_argument{ "Unknown engine " + opts.engine };
+
+        if (fd != STDOUT_FILENO && ::close(fd) != 0)
+            throw std::runtime_error{ std::string{ "close failed: " } + std::strerror(errno) };
+    }
+    catch (std::invalid_argument& e)
+    {
+        std::cerr << "prng-gen: " << e.what() << "\n\n";
+        usage(std::cerr);
+        std::exit(EXIT_FAILURE);
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << "prng-gen: " << e.what() << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+
+    return 0;
+}